@@ -1,160 +1,638 @@
 /*
 Este programa gera logs de acesso a memoria em diferentes padroes.
 Padroes disponiveis:
-1. Sequencial: Acessos sequenciais a memoria.
-2. Aleatorio: Acessos aleatorios a memoria.
-3. Localidade Temporal: Acessos a um conjunto pequeno de enderecos, repetidos ao longo do tempo.
-4. Localidade Espacial: Acessos a blocos de memoria proximos entre si, com mudancas periodicas de base.
+- sequencial: Acessos sequenciais a memoria.
+- aleatorio:  Acessos aleatorios a memoria.
+- temporal:   Acessos a um conjunto pequeno de enderecos, repetidos ao longo do tempo.
+- espacial:   Acessos a blocos de memoria proximos entre si, com mudancas periodicas de base.
+- zipf:       Paginas escolhidas com distribuicao de Zipf (poucas paginas muito quentes).
+- matriz:     Percurso por colunas de uma matriz armazenada por linhas (passo grande).
+- laco:       Varredura sequencial repetida de uma regiao (laco sobre um vetor).
+- fases:      Sequencia de fases, cada uma com um dos padroes acima sorteado e em outra regiao.
+
+A saida e um log texto ("%08x R|W" por linha) ou o trace binario compacto
+do simulador (TP02/trace_binario.h), escolhido com -b ou pela extensao ".bin".
+O trace e dividido em blocos de 65536 acessos gerados em paralelo; cada bloco
+tem seu proprio gerador pseudoaleatorio derivado da semente, entao a mesma
+semente produz o mesmo trace com qualquer numero de threads.
 
 Informacoes de como rodar este arquivo de apoio:
-- Compilar: gcc gerador_log.c -o gerador_log
-- Executar: ./gerador_log
+- Compilar: gcc -O2 -pthread gerador_log.c -o gerador_log -lm
+- Executar: ./gerador_log [opcoes] <padrao> <num_acessos> <saida>
+  Ex: ./gerador_log -s 42 zipf 100m zipf.bin
+      ./gerador_log -m 2048 laco 1m - | ./simulador lru - 4 4096
 */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 #include <stdint.h>
 #include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
 
-#define NUMERO_DE_ACESSOS 1000000
-#define ARQUIVO_DE_SAIDA_BASE "log.log"
-#define HOTSPOT_SIZE 250
+#define TAM_PAGINA 4096
 #define JANELA_ESPACIAL 4096
+#define ESPACO_ENDERECOS (1ULL << 32)
+
+// Mesmo formato de TP02/trace_binario.h
+#define TRACE_BIN_ASSINATURA "\x89TRC"
+#define TRACE_BIN_VERSAO 1
+#define TRACE_BIN_TAM_CABECALHO 16
+#define TRACE_BIN_TAM_CABECALHO_BLOCO 8
+#define TRACE_BIN_ACESSOS_POR_BLOCO 65536
+#define TRACE_BIN_MAX_VARINT 5
+
+#define TAM_LINHA 11
+#define BLOCOS_POR_THREAD 4
+#define TAM_BUFFER_BLOCO ((size_t)TRACE_BIN_ACESSOS_POR_BLOCO * TAM_LINHA)
+
+typedef enum {
+    SEQUENCIAL,
+    ALEATORIO,
+    TEMPORAL,
+    ESPACIAL,
+    ZIPF,
+    MATRIZ,
+    LACO,
+    FASES
+} Padrao;
+
+static const char* nomes_padroes[] = {
+    "sequencial", "aleatorio", "temporal", "espacial", "zipf", "matriz", "laco", "fases"
+};
+
+// Padroes sorteados para cada fase do padrao "fases"
+static const Padrao padroes_fase[] = { ZIPF, MATRIZ, LACO, ALEATORIO, TEMPORAL };
+#define NUM_PADROES_FASE (sizeof(padroes_fase) / sizeof(padroes_fase[0]))
+
+typedef struct {
+    Padrao padrao;
+    uint64_t num_acessos;
+    uint64_t semente;
+    uint64_t tam_fase;        // acessos por fase (fases e espacial)
+    uint32_t limiar_escrita;  // escrita se 32 bits aleatorios < limiar
+
+    // Parametros dos padroes, ja com os valores padrao aplicados
+    uint32_t passo_sequencial;
+    uint32_t passo_laco;
+    uint32_t paginas_laco;
+    uint32_t elemento_matriz;
+    uint32_t linhas, colunas;
+    uint32_t tam_quente;
+    uint32_t paginas_zipf;
+
+    // Tabelas compartilhadas (somente leitura durante a geracao)
+    uint32_t* quentes;        // conjunto quente do padrao temporal
+    struct EntradaZipf* zipf; // metodo alias para amostrar a distribuicao de Zipf
+
+    int binario;
+} Gerador;
+
+// Uma posicao da tabela alias, ja com as paginas sorteadas (uma linha de cache por amostra)
+typedef struct EntradaZipf {
+    uint32_t limiar;          // fica com 'pagina' se 32 bits aleatorios < limiar
+    uint32_t pagina;
+    uint32_t pagina_alias;
+} EntradaZipf;
+
+// Parametros da fase corrente
+typedef struct {
+    Padrao padrao;
+    uint64_t indice;
+    uint64_t inicio, fim;     // acessos [inicio, fim)
+    uint32_t base;            // inicio da regiao acessada
+    uint32_t rotacao_zipf;    // muda as paginas quentes de uma fase para outra
+} Fase;
+
 
-char gerar_operacao() {
-    return (rand() % 2 == 0) ? 'R' : 'W';
+// --- GERADOR PSEUDOALEATORIO (xoshiro256**) ---
+
+typedef struct {
+    uint64_t s[4];
+} Aleatorio;
+
+static inline uint64_t misturar(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
 }
 
-void gerar_acesso_sequencial(const char *filename, int num_acessos) {
-    FILE *f = fopen(filename, "w");
-    if (f == NULL) {
-        printf("Erro ao abrir o arquivo %s\n", filename);
-        return;
+static void aleatorio_iniciar(Aleatorio* r, uint64_t semente) {
+    for (int i = 0; i < 4; i++) {
+        semente = misturar(semente);
+        r->s[i] = semente;
     }
+}
 
-    printf("Gerando padrao SEQUENCIAL em '%s'...\n", filename);
-    uint32_t endereco_atual = 0;
-    const uint32_t passo = 4;
+static inline uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
 
-    for (int i = 0; i < num_acessos; ++i) {
-        fprintf(f, "%08x %c\n", endereco_atual, gerar_operacao());
-        endereco_atual += passo;
+static inline uint64_t aleatorio_proximo(Aleatorio* r) {
+    uint64_t resultado = rotl(r->s[1] * 5, 7) * 9;
+    uint64_t t = r->s[1] << 17;
+    r->s[2] ^= r->s[0];
+    r->s[3] ^= r->s[1];
+    r->s[1] ^= r->s[2];
+    r->s[0] ^= r->s[3];
+    r->s[2] ^= t;
+    r->s[3] = rotl(r->s[3], 45);
+    return resultado;
+}
+
+// Inteiro uniforme em [0, n) a partir de 32 bits aleatorios (multiplicacao de Lemire)
+static inline uint32_t limitar(uint32_t x, uint32_t n) {
+    return (uint32_t)(((uint64_t)x * n) >> 32);
+}
+
+
+// --- TABELAS ---
+
+static void criar_quentes(Gerador* g, Aleatorio* r) {
+    g->quentes = malloc(g->tam_quente * sizeof(uint32_t));
+    for (uint32_t i = 0; i < g->tam_quente; i++) {
+        g->quentes[i] = (uint32_t)aleatorio_proximo(r);
     }
+}
+
+// Monta as tabelas do metodo alias (Vose) para P(posicao k) proporcional a 1/(k+1)^alfa,
+// o que permite sortear uma pagina em tempo constante
+static void criar_zipf(Gerador* g, Aleatorio* r, double alfa) {
+    uint32_t n = g->paginas_zipf;
+    double* escala = malloc(n * sizeof(double));
+    uint32_t* pequenos = malloc(n * sizeof(uint32_t));
+    uint32_t* grandes = malloc(n * sizeof(uint32_t));
+    uint32_t* alias = malloc(n * sizeof(uint32_t));
+    uint32_t* pagina = malloc(n * sizeof(uint32_t));
+    g->zipf = malloc(n * sizeof(EntradaZipf));
 
-    fclose(f);
-    printf("Concluido!\n");
+    double soma = 0.0;
+    for (uint32_t k = 0; k < n; k++) {
+        escala[k] = pow((double)(k + 1), -alfa);
+        soma += escala[k];
+    }
+
+    uint32_t num_pequenos = 0, num_grandes = 0;
+    for (uint32_t k = 0; k < n; k++) {
+        escala[k] = escala[k] * n / soma;
+        if (escala[k] < 1.0) pequenos[num_pequenos++] = k;
+        else grandes[num_grandes++] = k;
+    }
+    while (num_pequenos > 0 && num_grandes > 0) {
+        uint32_t p = pequenos[--num_pequenos];
+        uint32_t q = grandes[--num_grandes];
+        g->zipf[p].limiar = (uint32_t)(escala[p] * 4294967296.0);
+        alias[p] = q;
+        escala[q] -= 1.0 - escala[p];
+        if (escala[q] < 1.0) pequenos[num_pequenos++] = q;
+        else grandes[num_grandes++] = q;
+    }
+    // Sobras (por arredondamento) ficam sempre com a propria posicao
+    while (num_grandes > 0) {
+        uint32_t q = grandes[--num_grandes];
+        g->zipf[q].limiar = UINT32_MAX;
+        alias[q] = q;
+    }
+    while (num_pequenos > 0) {
+        uint32_t p = pequenos[--num_pequenos];
+        g->zipf[p].limiar = UINT32_MAX;
+        alias[p] = p;
+    }
+
+    // Espalha as paginas quentes pela regiao (Fisher-Yates)
+    for (uint32_t k = 0; k < n; k++) pagina[k] = k;
+    for (uint32_t k = n - 1; k > 0; k--) {
+        uint32_t j = limitar((uint32_t)aleatorio_proximo(r), k + 1);
+        uint32_t t = pagina[k];
+        pagina[k] = pagina[j];
+        pagina[j] = t;
+    }
+    for (uint32_t k = 0; k < n; k++) {
+        g->zipf[k].pagina = pagina[k];
+        g->zipf[k].pagina_alias = pagina[alias[k]];
+    }
+
+    free(escala);
+    free(alias);
+    free(pagina);
+    free(pequenos);
+    free(grandes);
+}
+
+static void destruir_tabelas(Gerador* g) {
+    free(g->quentes);
+    free(g->zipf);
 }
 
-void gerar_acesso_aleatorio(const char *filename, int num_acessos) {
-    FILE *f = fopen(filename, "w");
-    if (f == NULL) {
-        printf("Erro ao abrir o arquivo %s\n", filename);
-        return;
+
+// --- PADROES ---
+
+// Tamanho em bytes da regiao acessada pelo padrao
+static uint64_t tamanho_regiao(const Gerador* g, Padrao padrao) {
+    switch (padrao) {
+        case ESPACIAL: return JANELA_ESPACIAL;
+        case ZIPF:     return (uint64_t)g->paginas_zipf * TAM_PAGINA;
+        case LACO:     return (uint64_t)g->paginas_laco * TAM_PAGINA;
+        case MATRIZ:   return (uint64_t)g->linhas * g->colunas * g->elemento_matriz;
+        default:       return ESPACO_ENDERECOS;
     }
+}
 
-    printf("Gerando padrao ALEATORIO em '%s'...\n", filename);
+// Os parametros de cada fase dependem so da semente e do indice da fase
+static void configurar_fase(const Gerador* g, uint64_t indice, Fase* f) {
+    uint64_t h = misturar(g->semente ^ misturar(indice));
+    f->indice = indice;
+    f->padrao = g->padrao == FASES ? padroes_fase[h % NUM_PADROES_FASE] : g->padrao;
+    f->inicio = indice * g->tam_fase;
+    f->fim = f->inicio + g->tam_fase;
 
-    for (int i = 0; i < num_acessos; ++i) {
-        uint32_t endereco_aleatorio = rand();
-        endereco_aleatorio = (endereco_aleatorio << 17) ^ (rand());
-        fprintf(f, "%08x %c\n", endereco_aleatorio, gerar_operacao());
+    uint64_t regiao = tamanho_regiao(g, f->padrao);
+    f->base = 0;
+    if (f->padrao != SEQUENCIAL && regiao < ESPACO_ENDERECOS) {
+        uint64_t deslocamento = (h >> 16) % (ESPACO_ENDERECOS - regiao + 1);
+        f->base = (uint32_t)(deslocamento & ~(uint64_t)(TAM_PAGINA - 1));
     }
+    f->rotacao_zipf = g->paginas_zipf ? (uint32_t)((h >> 40) % g->paginas_zipf) : 0;
+}
 
-    fclose(f);
-    printf("Concluido!\n");
+// Endereco do acesso 'i'. 'bits' sao 32 bits aleatorios ja sorteados para este acesso
+static inline uint32_t gerar_endereco(const Gerador* g, const Fase* f, Aleatorio* r,
+                                      uint64_t i, uint32_t bits) {
+    uint64_t k = i - f->inicio;
+    switch (f->padrao) {
+        case SEQUENCIAL:
+            return (uint32_t)(i * g->passo_sequencial);
+        case ALEATORIO:
+            return bits;
+        case TEMPORAL:
+            return g->quentes[limitar(bits, g->tam_quente)];
+        case ESPACIAL:
+            return f->base + limitar(bits, JANELA_ESPACIAL);
+        case ZIPF: {
+            uint64_t sorteio = aleatorio_proximo(r);
+            const EntradaZipf* e = &g->zipf[limitar((uint32_t)(sorteio >> 32), g->paginas_zipf)];
+            uint32_t pagina = ((uint32_t)sorteio < e->limiar ? e->pagina : e->pagina_alias) + f->rotacao_zipf;
+            if (pagina >= g->paginas_zipf) pagina -= g->paginas_zipf;
+            return f->base + pagina * TAM_PAGINA + (bits & (TAM_PAGINA - 4));
+        }
+        case MATRIZ: {
+            // Elemento [linha][coluna] de uma matriz por linhas, percorrida coluna a coluna
+            uint64_t elementos = (uint64_t)g->linhas * g->colunas;
+            uint64_t e = k % elementos;
+            uint64_t coluna = e / g->linhas;
+            uint64_t linha = e % g->linhas;
+            return f->base + (uint32_t)((linha * g->colunas + coluna) * g->elemento_matriz);
+        }
+        case LACO: {
+            uint64_t posicoes = (uint64_t)g->paginas_laco * TAM_PAGINA / g->passo_laco;
+            return f->base + (uint32_t)((k % posicoes) * g->passo_laco);
+        }
+        default:
+            return 0;
+    }
 }
 
-void gerar_localidade_temporal(const char *filename, int num_acessos) {
-    FILE *f = fopen(filename, "w");
-    if (f == NULL) {
-        printf("Erro ao abrir o arquivo %s\n", filename);
-        return;
+
+// --- SAIDA ---
+
+static char pares_hex[256][2];
+
+static void iniciar_pares_hex(void) {
+    static const char hex[] = "0123456789abcdef";
+    for (int i = 0; i < 256; i++) {
+        pares_hex[i][0] = hex[i >> 4];
+        pares_hex[i][1] = hex[i & 0xF];
     }
+}
+
+static inline void escrever_u32(unsigned char* p, uint32_t v) {
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
 
-    printf("Gerando padrao com LOCALIDADE TEMPORAL em '%s'...\n", filename);
-    uint32_t hotspot[HOTSPOT_SIZE];
+static inline unsigned char* escrever_linha(unsigned char* p, uint32_t endereco, int escrita) {
+    memcpy(p, pares_hex[endereco >> 24], 2);
+    memcpy(p + 2, pares_hex[(endereco >> 16) & 0xFF], 2);
+    memcpy(p + 4, pares_hex[(endereco >> 8) & 0xFF], 2);
+    memcpy(p + 6, pares_hex[endereco & 0xFF], 2);
+    p[8] = ' ';
+    p[9] = escrita ? 'W' : 'R';
+    p[10] = '\n';
+    return p + TAM_LINHA;
+}
 
-    for (int i = 0; i < HOTSPOT_SIZE; ++i) {
-        uint32_t endereco_aleatorio = rand();
-        hotspot[i] = (endereco_aleatorio << 17) ^ (rand());
+// Varint com (zigzag(endereco - anterior) << 1) | escrita, como em trace_bin_codificar
+static inline unsigned char* escrever_varint(unsigned char* p, uint32_t endereco, uint32_t anterior, int escrita) {
+    int32_t delta = (int32_t)(endereco - anterior);
+    uint32_t zigzag = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+    uint64_t valor = ((uint64_t)zigzag << 1) | (escrita ? 1u : 0u);
+    while (valor >= 0x80) {
+        *p++ = (unsigned char)(valor | 0x80);
+        valor >>= 7;
     }
+    *p++ = (unsigned char)valor;
+    return p;
+}
+
+// Gera o bloco 'bloco' do trace em 'saida' (texto ou bloco binario com cabecalho).
+// Retorna o numero de bytes escritos
+static size_t gerar_bloco(const Gerador* g, uint64_t bloco, unsigned char* saida) {
+    uint64_t inicio = bloco * TRACE_BIN_ACESSOS_POR_BLOCO;
+    uint64_t fim = inicio + TRACE_BIN_ACESSOS_POR_BLOCO;
+    if (fim > g->num_acessos) fim = g->num_acessos;
+
+    Aleatorio r;
+    aleatorio_iniciar(&r, g->semente ^ misturar(~bloco));
+    Fase f;
+    configurar_fase(g, inicio / g->tam_fase, &f);
 
-    for (int i = 0; i < num_acessos; ++i) {
-        uint32_t endereco_escolhido = hotspot[rand() % HOTSPOT_SIZE];
-        fprintf(f, "%08x %c\n", endereco_escolhido, gerar_operacao());
+    unsigned char* p = g->binario ? saida + TRACE_BIN_TAM_CABECALHO_BLOCO : saida;
+    uint32_t anterior = 0;
+    for (uint64_t i = inicio; i < fim; i++) {
+        if (i >= f.fim) configurar_fase(g, f.indice + 1, &f);
+        uint64_t sorteio = aleatorio_proximo(&r);
+        uint32_t endereco = gerar_endereco(g, &f, &r, i, (uint32_t)sorteio);
+        int escrita = (uint32_t)(sorteio >> 32) < g->limiar_escrita;
+        if (g->binario) {
+            p = escrever_varint(p, endereco, anterior, escrita);
+            anterior = endereco;
+        } else {
+            p = escrever_linha(p, endereco, escrita);
+        }
     }
 
-    fclose(f);
-    printf("Concluido!\n");
+    if (g->binario) {
+        escrever_u32(saida, (uint32_t)(fim - inicio));
+        escrever_u32(saida + 4, (uint32_t)(p - saida - TRACE_BIN_TAM_CABECALHO_BLOCO));
+    }
+    return (size_t)(p - saida);
 }
 
-void gerar_localidade_espacial(const char *filename, int num_acessos) {
-    FILE *f = fopen(filename, "w");
-    if (f == NULL) {
-        printf("Erro ao abrir o arquivo %s\n", filename);
-        return;
+typedef struct {
+    const Gerador* g;
+    uint64_t primeiro_bloco;
+    uint64_t num_blocos;
+    unsigned char** buffers;
+    size_t* tamanhos;
+} TarefaGeracao;
+
+static void* executar_tarefa(void* arg) {
+    TarefaGeracao* t = (TarefaGeracao*)arg;
+    for (uint64_t b = 0; b < t->num_blocos; b++) {
+        t->tamanhos[b] = gerar_bloco(t->g, t->primeiro_bloco + b, t->buffers[b]);
     }
+    return NULL;
+}
 
-    printf("Gerando padrao com LOCALIDADE ESPACIAL em '%s'...\n", filename);
+// Gera todos os blocos em rodadas: cada thread preenche BLOCOS_POR_THREAD
+// blocos consecutivos e a thread principal os grava em ordem
+static int gerar_trace(const Gerador* g, FILE* saida, int num_threads) {
+    uint64_t total_blocos = (g->num_acessos + TRACE_BIN_ACESSOS_POR_BLOCO - 1) / TRACE_BIN_ACESSOS_POR_BLOCO;
+    size_t por_rodada = (size_t)num_threads * BLOCOS_POR_THREAD;
 
-    uint32_t endereco_base_rand = rand();
-    uint32_t endereco_base = (endereco_base_rand << 17) ^ (rand());
-    if (endereco_base > (UINT32_MAX - JANELA_ESPACIAL)) {
-        endereco_base = UINT32_MAX - JANELA_ESPACIAL;
+    unsigned char** buffers = malloc(por_rodada * sizeof(unsigned char*));
+    size_t* tamanhos = malloc(por_rodada * sizeof(size_t));
+    pthread_t* threads = malloc(num_threads * sizeof(pthread_t));
+    TarefaGeracao* tarefas = malloc(num_threads * sizeof(TarefaGeracao));
+    int ok = buffers && tamanhos && threads && tarefas;
+    for (size_t i = 0; ok && i < por_rodada; i++) {
+        buffers[i] = malloc(TAM_BUFFER_BLOCO);
+        if (!buffers[i]) {
+            for (size_t j = 0; j < i; j++) free(buffers[j]);
+            ok = 0;
+        }
+    }
+    if (!ok) {
+        fprintf(stderr, "Erro: memoria insuficiente para os buffers de geracao\n");
+        free(buffers);
+        free(tamanhos);
+        free(threads);
+        free(tarefas);
+        return 0;
     }
 
-    for (int i = 0; i < num_acessos; ++i) {
-        if (i > 0 && i % (num_acessos / 4) == 0) {
-            endereco_base_rand = rand();
-            endereco_base = (endereco_base_rand << 17) ^ (rand());
-            if (endereco_base > (UINT32_MAX - JANELA_ESPACIAL)) {
-                endereco_base = UINT32_MAX - JANELA_ESPACIAL;
+    if (g->binario) {
+        unsigned char cabecalho[TRACE_BIN_TAM_CABECALHO] = { 0 };
+        memcpy(cabecalho, TRACE_BIN_ASSINATURA, 4);
+        cabecalho[4] = TRACE_BIN_VERSAO;
+        escrever_u32(cabecalho + 8, (uint32_t)g->num_acessos);
+        escrever_u32(cabecalho + 12, (uint32_t)(g->num_acessos >> 32));
+        ok = fwrite(cabecalho, 1, sizeof(cabecalho), saida) == sizeof(cabecalho);
+    }
+
+    for (uint64_t primeiro = 0; ok && primeiro < total_blocos; primeiro += por_rodada) {
+        uint64_t restantes = total_blocos - primeiro;
+        size_t nesta_rodada = restantes < por_rodada ? (size_t)restantes : por_rodada;
+
+        int lancadas = 0;
+        for (size_t b = 0; b < nesta_rodada; b += BLOCOS_POR_THREAD) {
+            TarefaGeracao* t = &tarefas[lancadas];
+            t->g = g;
+            t->primeiro_bloco = primeiro + b;
+            t->num_blocos = nesta_rodada - b < BLOCOS_POR_THREAD ? nesta_rodada - b : BLOCOS_POR_THREAD;
+            t->buffers = &buffers[b];
+            t->tamanhos = &tamanhos[b];
+            if (num_threads == 1 || pthread_create(&threads[lancadas], NULL, executar_tarefa, t) != 0) {
+                executar_tarefa(t);
+            } else {
+                lancadas++;
             }
         }
-        uint32_t offset = rand() % JANELA_ESPACIAL;
-        fprintf(f, "%08x %c\n", endereco_base + offset, gerar_operacao());
-    }
-
-    fclose(f);
-    printf("Concluido!\n");
-}
-
-int main() {
-    srand(time(NULL));
-    char escolha;
-    char filename[100];
-
-    printf("Escolha o padrao de acesso a memoria para gerar:\n");
-    printf("1: Sequencial\n");
-    printf("2: Aleatorio\n");
-    printf("3: Localidade Temporal\n");
-    printf("4: Localidade Espacial\n");
-    printf("Digite o numero do padrao desejado: ");
-    
-    scanf(" %c", &escolha);
-
-    switch (escolha) {
-        case '1':
-            snprintf(filename, sizeof(filename), "sequencial_%s", ARQUIVO_DE_SAIDA_BASE);
-            gerar_acesso_sequencial(filename, NUMERO_DE_ACESSOS);
-            break;
-        case '2':
-            snprintf(filename, sizeof(filename), "aleatorio_%s", ARQUIVO_DE_SAIDA_BASE);
-            gerar_acesso_aleatorio(filename, NUMERO_DE_ACESSOS);
-            break;
-        case '3':
-            snprintf(filename, sizeof(filename), "temporal_%s", ARQUIVO_DE_SAIDA_BASE);
-            gerar_localidade_temporal(filename, NUMERO_DE_ACESSOS);
-            break;
-        case '4':
-            snprintf(filename, sizeof(filename), "espacial_%s", ARQUIVO_DE_SAIDA_BASE);
-            gerar_localidade_espacial(filename, NUMERO_DE_ACESSOS);
-            break;
-        default:
-            printf("Opcao invalida.\n");
-            break;
+        for (int i = 0; i < lancadas; i++) pthread_join(threads[i], NULL);
+
+        for (size_t b = 0; ok && b < nesta_rodada; b++) {
+            ok = fwrite(buffers[b], 1, tamanhos[b], saida) == tamanhos[b];
+        }
     }
+    if (!ok) perror("Erro ao gravar o arquivo de saida");
+
+    for (size_t i = 0; i < por_rodada; i++) free(buffers[i]);
+    free(buffers);
+    free(tamanhos);
+    free(threads);
+    free(tarefas);
+    return ok;
+}
+
+
+// --- LINHA DE COMANDO ---
+
+// Le um numero com sufixo opcional k, m ou g (potencias de 1000)
+static int ler_quantidade(const char* texto, uint64_t* valor) {
+    char* fim;
+    unsigned long long n = strtoull(texto, &fim, 10);
+    if (fim == texto) return 0;
+    switch (*fim) {
+        case 'k': case 'K': n *= 1000ULL; fim++; break;
+        case 'm': case 'M': n *= 1000000ULL; fim++; break;
+        case 'g': case 'G': n *= 1000000000ULL; fim++; break;
+        default: break;
+    }
+    if (*fim != '\0') return 0;
+    *valor = n;
+    return 1;
+}
+
+static int ler_inteiro(const char* texto, uint32_t* valor) {
+    uint64_t n;
+    if (!ler_quantidade(texto, &n) || n == 0 || n > UINT32_MAX) return 0;
+    *valor = (uint32_t)n;
+    return 1;
+}
+
+static void imprimir_uso(const char* programa) {
+    fprintf(stderr, "Uso: %s [opcoes] <padrao> <num_acessos> <saida>\n", programa);
+    fprintf(stderr, "  padrao: sequencial, aleatorio, temporal, espacial, zipf, matriz, laco, fases\n");
+    fprintf(stderr, "  num_acessos aceita os sufixos k, m e g (ex: 500m, 1g)\n");
+    fprintf(stderr, "  saida: arquivo (\".bin\" gera trace binario) ou \"-\" para a saida padrao\n");
+    fprintf(stderr, "Opcoes:\n");
+    fprintf(stderr, "  -s <semente>   semente do gerador (padrao: relogio, informada na saida de erro)\n");
+    fprintf(stderr, "  -t <threads>   threads de geracao (padrao: processadores disponiveis)\n");
+    fprintf(stderr, "  -b             forca o formato binario\n");
+    fprintf(stderr, "  -w <fracao>    fracao de escritas, entre 0 e 1 (padrao: 0.5)\n");
+    fprintf(stderr, "  -m <n>         tamanho do conjunto: paginas (zipf: 65536, laco: 1024)\n");
+    fprintf(stderr, "                 ou enderecos quentes (temporal: 250)\n");
+    fprintf(stderr, "  -d <bytes>     passo (sequencial: 4, laco: 64) ou tamanho do elemento (matriz: 8)\n");
+    fprintf(stderr, "  -l <linhas>    linhas da matriz (padrao: 1024)\n");
+    fprintf(stderr, "  -c <colunas>   colunas da matriz (padrao: 1024)\n");
+    fprintf(stderr, "  -a <alfa>      expoente da distribuicao de Zipf (padrao: 0.99)\n");
+    fprintf(stderr, "  -f <acessos>   acessos por fase no padrao fases (padrao: 1m)\n");
+}
 
+int main(int argc, char* argv[]) {
+    Gerador g;
+    memset(&g, 0, sizeof(g));
+    g.semente = (uint64_t)time(NULL);
+    g.linhas = 1024;
+    g.colunas = 1024;
+    g.tam_fase = 1000000;
+
+    long processadores = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t num_threads = processadores > 0 ? (uint32_t)processadores : 1;
+    uint32_t conjunto = 0, passo = 0;
+    double fracao_escrita = 0.5, alfa = 0.99;
+    int forcar_binario = 0;
+
+    int opcao;
+    int erro = 0;
+    while ((opcao = getopt(argc, argv, "s:t:bw:m:d:l:c:a:f:")) != -1) {
+        char* fim = NULL;
+        switch (opcao) {
+            case 's': erro |= !ler_quantidade(optarg, &g.semente); break;
+            case 't': erro |= !ler_inteiro(optarg, &num_threads); break;
+            case 'b': forcar_binario = 1; break;
+            case 'w':
+                fracao_escrita = strtod(optarg, &fim);
+                erro |= *fim != '\0' || fracao_escrita < 0.0 || fracao_escrita > 1.0;
+                break;
+            case 'm': erro |= !ler_inteiro(optarg, &conjunto); break;
+            case 'd': erro |= !ler_inteiro(optarg, &passo); break;
+            case 'l': erro |= !ler_inteiro(optarg, &g.linhas); break;
+            case 'c': erro |= !ler_inteiro(optarg, &g.colunas); break;
+            case 'a':
+                alfa = strtod(optarg, &fim);
+                erro |= *fim != '\0' || alfa < 0.0;
+                break;
+            case 'f': erro |= !ler_quantidade(optarg, &g.tam_fase) || g.tam_fase == 0; break;
+            default: erro = 1; break;
+        }
+    }
+    if (erro || argc - optind != 3) {
+        imprimir_uso(argv[0]);
+        return 1;
+    }
+
+    const char* nome_padrao = argv[optind];
+    const char* nome_saida = argv[optind + 2];
+    int padrao_valido = 0;
+    for (size_t i = 0; i < sizeof(nomes_padroes) / sizeof(nomes_padroes[0]); i++) {
+        if (strcmp(nome_padrao, nomes_padroes[i]) == 0) {
+            g.padrao = (Padrao)i;
+            padrao_valido = 1;
+        }
+    }
+    if (!padrao_valido) {
+        fprintf(stderr, "Erro: padrao '%s' desconhecido.\n", nome_padrao);
+        imprimir_uso(argv[0]);
+        return 1;
+    }
+    if (!ler_quantidade(argv[optind + 1], &g.num_acessos) || g.num_acessos == 0) {
+        fprintf(stderr, "Erro: numero de acessos invalido '%s'.\n", argv[optind + 1]);
+        return 1;
+    }
+
+    size_t tam_nome = strlen(nome_saida);
+    g.binario = forcar_binario || (tam_nome > 4 && strcmp(nome_saida + tam_nome - 4, ".bin") == 0);
+    g.limiar_escrita = fracao_escrita >= 1.0 ? UINT32_MAX : (uint32_t)(fracao_escrita * 4294967296.0);
+    g.passo_sequencial = passo ? passo : 4;
+    g.passo_laco = passo ? passo : 64;
+    g.elemento_matriz = passo ? passo : 8;
+    g.paginas_laco = conjunto ? conjunto : 1024;
+    g.paginas_zipf = conjunto ? conjunto : 65536;
+    g.tam_quente = conjunto ? conjunto : 250;
+    if (g.padrao == ESPACIAL) {
+        // A base muda a cada quarto do trace, como no gerador original
+        g.tam_fase = g.num_acessos / 4 > 0 ? g.num_acessos / 4 : 1;
+    } else if (g.padrao != FASES) {
+        g.tam_fase = g.num_acessos;
+    }
+
+    for (Padrao p = ZIPF; p <= LACO; p++) {
+        int usado = g.padrao == p || g.padrao == FASES;
+        if (usado && tamanho_regiao(&g, p) > ESPACO_ENDERECOS) {
+            fprintf(stderr, "Erro: a regiao do padrao %s nao cabe em 32 bits de endereco.\n", nomes_padroes[p]);
+            return 1;
+        }
+    }
+    if (g.padrao == LACO || g.padrao == FASES) {
+        if ((uint64_t)g.paginas_laco * TAM_PAGINA < g.passo_laco) {
+            fprintf(stderr, "Erro: o passo do laco e maior que a regiao varrida.\n");
+            return 1;
+        }
+    }
+
+    Aleatorio r;
+    aleatorio_iniciar(&r, g.semente);
+    if (g.padrao == TEMPORAL || g.padrao == FASES) criar_quentes(&g, &r);
+    if (g.padrao == ZIPF || g.padrao == FASES) criar_zipf(&g, &r, alfa);
+    iniciar_pares_hex();
+
+    int saida_padrao = strcmp(nome_saida, "-") == 0;
+    FILE* saida = saida_padrao ? stdout : fopen(nome_saida, "wb");
+    if (saida == NULL) {
+        fprintf(stderr, "Erro ao abrir o arquivo %s\n", nome_saida);
+        destruir_tabelas(&g);
+        return 1;
+    }
+
+    fprintf(stderr, "Gerando padrao %s (%llu acessos, semente %llu, %u threads) em '%s'...\n",
+            nomes_padroes[g.padrao], (unsigned long long)g.num_acessos,
+            (unsigned long long)g.semente, num_threads, nome_saida);
+
+    struct timespec inicio, fim;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    int ok = gerar_trace(&g, saida, (int)num_threads);
+    if (saida_padrao) {
+        if (fflush(saida) != 0) ok = 0;
+    } else if (fclose(saida) != 0) {
+        ok = 0;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+    destruir_tabelas(&g);
+
+    if (!ok) {
+        fprintf(stderr, "Erro ao gravar o arquivo %s\n", nome_saida);
+        return 1;
+    }
+    double segundos = (fim.tv_sec - inicio.tv_sec) + (fim.tv_nsec - inicio.tv_nsec) / 1e9;
+    fprintf(stderr, "Concluido em %.2f s (%.1f milhoes de acessos/s).\n",
+            segundos, segundos > 0 ? g.num_acessos / segundos / 1e6 : 0.0);
     return 0;
-}
\ No newline at end of file
+}
@@ -1,9 +1,9 @@
 #include <stdlib.h>
+#include <string.h>
 #include <limits.h>
+#include <stdint.h>
 #include "algoritmos.h"
-
-// Ponteiro para o próximo frame a ser substituído no algoritmo FIFO
-static int ponteiro_fifo = 0;
+#include "mapa_paginas.h"
 
 // LRU: Least Recently Used (O Menos Recentemente Usado)
 // Encontra o quadro cujo último acesso foi o mais antigo no tempo
@@ -40,17 +40,1259 @@ int encontrar_vitima_lfu(Frame* memoria_fisica, int num_quadros) {
     return indice_vitima;
 }
 
-// FIFO: First-In, First-Out
+// --- POLÍTICA SIMPLES: delega a escolha a uma função de varredura ---
+
+// Libera políticas cujo estado é um único bloco alocado
+static void destroy_estado_simples(Politica* p) {
+    free(p->impl);
+    free(p);
+}
+
+typedef struct {
+    int (*encontrar_vitima)(Frame*, int);
+} EstadoSimples;
+
+static int escolher_vitima_simples(Politica* p, Frame* memoria_fisica, int num_quadros) {
+    return ((EstadoSimples*)p->impl)->encontrar_vitima(memoria_fisica, num_quadros);
+}
+
+Politica* politica_simples_create(int (*encontrar_vitima)(Frame*, int)) {
+    Politica* p = malloc(sizeof(Politica));
+    EstadoSimples* e = malloc(sizeof(EstadoSimples));
+    e->encontrar_vitima = encontrar_vitima;
+    p->impl = e;
+    p->escolher_vitima = escolher_vitima_simples;
+    p->registrar_falta = NULL;
+    p->registrar_acesso = NULL;
+    p->registrar_carga = NULL;
+    p->registrar_escrita = NULL;
+    p->gravar_quadro = NULL;
+    p->contexto_gravacao = NULL;
+    p->destroy = destroy_estado_simples;
+    return p;
+}
+
+
+// --- LRU EM O(1): LISTA DE RECÊNCIA INTRUSIVA ---
+// Os quadros formam uma lista duplamente ligada por índices, do mais recente
+// para o menos recente. Cada hit ou carga move o quadro para a frente, e a
+// vítima é sempre o fim da lista. Como os tempos de acesso são únicos, a
+// escolha é idêntica à de encontrar_vitima_lru
+
+#define FORA_DA_LISTA -2
+
+typedef struct {
+    int* anterior;
+    int* proximo;
+    int mais_recente;
+    int menos_recente;
+} EstadoLRU;
+
+static void lru_remover(EstadoLRU* e, int quadro) {
+    int ant = e->anterior[quadro];
+    int prox = e->proximo[quadro];
+    if (ant != -1) e->proximo[ant] = prox;
+    else e->mais_recente = prox;
+    if (prox != -1) e->anterior[prox] = ant;
+    else e->menos_recente = ant;
+}
+
+static void lru_mover_para_frente(Politica* p, int quadro) {
+    EstadoLRU* e = (EstadoLRU*)p->impl;
+    if (e->mais_recente == quadro) return;
+    if (e->anterior[quadro] != FORA_DA_LISTA) lru_remover(e, quadro);
+
+    e->anterior[quadro] = -1;
+    e->proximo[quadro] = e->mais_recente;
+    if (e->mais_recente != -1) e->anterior[e->mais_recente] = quadro;
+    else e->menos_recente = quadro;
+    e->mais_recente = quadro;
+}
+
+static int escolher_vitima_lru(Politica* p, Frame* memoria_fisica, int num_quadros) {
+    (void)memoria_fisica;
+    (void)num_quadros;
+    return ((EstadoLRU*)p->impl)->menos_recente;
+}
+
+static void destroy_lru(Politica* p) {
+    EstadoLRU* e = (EstadoLRU*)p->impl;
+    free(e->anterior);
+    free(e->proximo);
+    free(e);
+    free(p);
+}
+
+Politica* politica_lru_create(int num_quadros) {
+    Politica* p = malloc(sizeof(Politica));
+    EstadoLRU* e = malloc(sizeof(EstadoLRU));
+    p->impl = e;
+    p->escolher_vitima = escolher_vitima_lru;
+    p->registrar_falta = NULL;
+    p->registrar_acesso = lru_mover_para_frente;
+    p->registrar_carga = lru_mover_para_frente;
+    p->registrar_escrita = NULL;
+    p->gravar_quadro = NULL;
+    p->contexto_gravacao = NULL;
+    p->destroy = destroy_lru;
+
+    e->anterior = malloc(num_quadros * sizeof(int));
+    e->proximo = malloc(num_quadros * sizeof(int));
+    for (int i = 0; i < num_quadros; i++) {
+        e->anterior[i] = FORA_DA_LISTA;
+        e->proximo[i] = FORA_DA_LISTA;
+    }
+    e->mais_recente = -1;
+    e->menos_recente = -1;
+    return p;
+}
+
+
+// --- LFU EM O(1): BALDES DE FREQUÊNCIA ---
+// Cada balde agrupa os quadros com a mesma frequência de acesso, e os baldes
+// formam uma lista em ordem crescente de frequência. Dentro de um balde os
+// quadros ficam na ordem em que entraram nele, que é a ordem do último acesso,
+// pois um quadro só muda de balde ao ser acessado. A vítima é o primeiro quadro
+// do primeiro balde: menor frequência e, no empate, o menos recentemente usado
+
+typedef struct {
+    long frequencia;
+    int primeiro;  // quadro mais antigo do balde
+    int ultimo;    // quadro mais recente do balde
+    int anterior;  // balde de frequência menor
+    int proximo;   // balde de frequência maior
+} BaldeLFU;
+
+typedef struct {
+    BaldeLFU* baldes;
+    int* baldes_livres;
+    int num_baldes_livres;
+    int menor_balde;      // balde de menor frequência (início da lista)
+
+    int* balde_do_quadro; // -1 se o quadro ainda não foi carregado
+    int* anterior;        // vizinhos do quadro dentro do balde
+    int* proximo;
+} EstadoLFU;
+
+// Cria um balde vazio logo após 'apos' (-1 para criar no início da lista)
+static int lfu_criar_balde(EstadoLFU* e, int apos, long frequencia) {
+    int b = e->baldes_livres[--e->num_baldes_livres];
+    BaldeLFU* balde = &e->baldes[b];
+    balde->frequencia = frequencia;
+    balde->primeiro = -1;
+    balde->ultimo = -1;
+    balde->anterior = apos;
+    balde->proximo = (apos == -1) ? e->menor_balde : e->baldes[apos].proximo;
+    if (balde->proximo != -1) e->baldes[balde->proximo].anterior = b;
+    if (apos == -1) e->menor_balde = b;
+    else e->baldes[apos].proximo = b;
+    return b;
+}
+
+// Retira o quadro do seu balde, descartando o balde se ele ficar vazio
+static void lfu_remover_quadro(EstadoLFU* e, int quadro) {
+    int b = e->balde_do_quadro[quadro];
+    BaldeLFU* balde = &e->baldes[b];
+    int ant = e->anterior[quadro];
+    int prox = e->proximo[quadro];
+    if (ant != -1) e->proximo[ant] = prox;
+    else balde->primeiro = prox;
+    if (prox != -1) e->anterior[prox] = ant;
+    else balde->ultimo = ant;
+    e->balde_do_quadro[quadro] = -1;
+
+    if (balde->primeiro == -1) {
+        if (balde->anterior != -1) e->baldes[balde->anterior].proximo = balde->proximo;
+        else e->menor_balde = balde->proximo;
+        if (balde->proximo != -1) e->baldes[balde->proximo].anterior = balde->anterior;
+        e->baldes_livres[e->num_baldes_livres++] = b;
+    }
+}
+
+static void lfu_inserir_quadro(EstadoLFU* e, int b, int quadro) {
+    BaldeLFU* balde = &e->baldes[b];
+    e->balde_do_quadro[quadro] = b;
+    e->anterior[quadro] = balde->ultimo;
+    e->proximo[quadro] = -1;
+    if (balde->ultimo != -1) e->proximo[balde->ultimo] = quadro;
+    else balde->primeiro = quadro;
+    balde->ultimo = quadro;
+}
+
+static void lfu_registrar_acesso(Politica* p, int quadro) {
+    EstadoLFU* e = (EstadoLFU*)p->impl;
+    int b = e->balde_do_quadro[quadro];
+    long nova_frequencia = e->baldes[b].frequencia + 1;
+
+    int destino = e->baldes[b].proximo;
+    if (destino == -1 || e->baldes[destino].frequencia != nova_frequencia) {
+        destino = lfu_criar_balde(e, b, nova_frequencia);
+    }
+    lfu_remover_quadro(e, quadro);
+    lfu_inserir_quadro(e, destino, quadro);
+}
+
+static void lfu_registrar_carga(Politica* p, int quadro) {
+    EstadoLFU* e = (EstadoLFU*)p->impl;
+    if (e->balde_do_quadro[quadro] != -1) lfu_remover_quadro(e, quadro);
+
+    int destino = e->menor_balde;
+    if (destino == -1 || e->baldes[destino].frequencia != 1) {
+        destino = lfu_criar_balde(e, -1, 1);
+    }
+    lfu_inserir_quadro(e, destino, quadro);
+}
+
+static int escolher_vitima_lfu(Politica* p, Frame* memoria_fisica, int num_quadros) {
+    (void)memoria_fisica;
+    (void)num_quadros;
+    EstadoLFU* e = (EstadoLFU*)p->impl;
+    return e->baldes[e->menor_balde].primeiro;
+}
+
+static void destroy_lfu(Politica* p) {
+    EstadoLFU* e = (EstadoLFU*)p->impl;
+    free(e->baldes);
+    free(e->baldes_livres);
+    free(e->balde_do_quadro);
+    free(e->anterior);
+    free(e->proximo);
+    free(e);
+    free(p);
+}
+
+Politica* politica_lfu_create(int num_quadros) {
+    Politica* p = malloc(sizeof(Politica));
+    EstadoLFU* e = malloc(sizeof(EstadoLFU));
+    p->impl = e;
+    p->escolher_vitima = escolher_vitima_lfu;
+    p->registrar_falta = NULL;
+    p->registrar_acesso = lfu_registrar_acesso;
+    p->registrar_carga = lfu_registrar_carga;
+    p->registrar_escrita = NULL;
+    p->gravar_quadro = NULL;
+    p->contexto_gravacao = NULL;
+    p->destroy = destroy_lfu;
+
+    // No máximo um balde por quadro, mais um criado antes de o antigo ser descartado
+    int max_baldes = num_quadros + 1;
+    e->baldes = malloc(max_baldes * sizeof(BaldeLFU));
+    e->baldes_livres = malloc(max_baldes * sizeof(int));
+    for (int i = 0; i < max_baldes; i++) {
+        e->baldes_livres[i] = max_baldes - 1 - i;
+    }
+    e->num_baldes_livres = max_baldes;
+    e->menor_balde = -1;
+
+    e->balde_do_quadro = malloc(num_quadros * sizeof(int));
+    e->anterior = malloc(num_quadros * sizeof(int));
+    e->proximo = malloc(num_quadros * sizeof(int));
+    for (int i = 0; i < num_quadros; i++) {
+        e->balde_do_quadro[i] = -1;
+    }
+    return p;
+}
+
+
+// --- FIFO: First-In, First-Out ---
 // Substitui a página que está na memória há mais tempo, usando um ponteiro circular
-int encontrar_vitima_fifo(Frame* memoria_fisica, int num_quadros) {
+
+typedef struct {
+    int ponteiro; // Próximo frame a ser substituído
+} EstadoFIFO;
+
+static int escolher_vitima_fifo(Politica* p, Frame* memoria_fisica, int num_quadros) {
     (void)memoria_fisica; // Evita warning de "unused parameter"
-    int vitima = ponteiro_fifo;
-    ponteiro_fifo = (ponteiro_fifo + 1) % num_quadros;
+    EstadoFIFO* e = (EstadoFIFO*)p->impl;
+    int vitima = e->ponteiro;
+    e->ponteiro = (e->ponteiro + 1) % num_quadros;
     return vitima;
 }
 
-// Aleatório: Escolhe uma página para substituir de forma aleatória
-int encontrar_vitima_random(Frame* memoria_fisica, int num_quadros) {
+Politica* politica_fifo_create(void) {
+    Politica* p = malloc(sizeof(Politica));
+    EstadoFIFO* e = malloc(sizeof(EstadoFIFO));
+    e->ponteiro = 0;
+    p->impl = e;
+    p->escolher_vitima = escolher_vitima_fifo;
+    p->registrar_falta = NULL;
+    p->registrar_acesso = NULL;
+    p->registrar_carga = NULL;
+    p->registrar_escrita = NULL;
+    p->gravar_quadro = NULL;
+    p->contexto_gravacao = NULL;
+    p->destroy = destroy_estado_simples;
+    return p;
+}
+
+
+// --- ALEATÓRIO ---
+// Escolhe uma página para substituir de forma aleatória. Cada instância tem seu
+// próprio gerador (xorshift64*), então simulações paralelas não interferem entre si
+
+typedef struct {
+    unsigned long long estado;
+} EstadoRandom;
+
+static int escolher_vitima_random(Politica* p, Frame* memoria_fisica, int num_quadros) {
     (void)memoria_fisica; // Evita warning de "unused parameter"
-    return random() % num_quadros;
+    EstadoRandom* e = (EstadoRandom*)p->impl;
+    e->estado ^= e->estado >> 12;
+    e->estado ^= e->estado << 25;
+    e->estado ^= e->estado >> 27;
+    unsigned long long r = e->estado * 0x2545F4914F6CDD1DULL;
+    return (int)((r >> 32) % (unsigned long long)num_quadros);
+}
+
+Politica* politica_random_create(unsigned long long semente) {
+    Politica* p = malloc(sizeof(Politica));
+    EstadoRandom* e = malloc(sizeof(EstadoRandom));
+    // O estado do xorshift nunca pode ser zero
+    e->estado = semente ? semente : 0x9E3779B97F4A7C15ULL;
+    p->impl = e;
+    p->escolher_vitima = escolher_vitima_random;
+    p->registrar_falta = NULL;
+    p->registrar_acesso = NULL;
+    p->registrar_carga = NULL;
+    p->registrar_escrita = NULL;
+    p->gravar_quadro = NULL;
+    p->contexto_gravacao = NULL;
+    p->destroy = destroy_estado_simples;
+    return p;
+}
+
+
+// --- RELÓGIO: CLOCK, SEGUNDA CHANCE MELHORADA E WSCLOCK ---
+// Os quadros formam um círculo percorrido por um ponteiro. Os bits de
+// referência e sujo ficam empacotados em vetores de uint64_t (64 quadros por
+// palavra), o que permite ao CLOCK e à segunda chance examinar e limpar 64
+// quadros por operação em vez de um a um
+
+typedef struct {
+    uint64_t* referencia;
+    uint64_t* suja;
+    int num_palavras;
+    int num_quadros;
+    int ponteiro;
+
+    // WSClock: relógio virtual (um tique por acesso ou carga notificada), instante
+    // do último uso de cada quadro nesse relógio e janela do conjunto de trabalho
+    long relogio;
+    long* ultimo_uso;
+    long tau;
+} EstadoRelogio;
+
+// Índice do bit menos significativo ligado (x != 0)
+static inline int primeiro_bit(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    int i = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+static inline void bit_ligar(uint64_t* v, int i) { v[i >> 6] |= 1ULL << (i & 63); }
+static inline void bit_desligar(uint64_t* v, int i) { v[i >> 6] &= ~(1ULL << (i & 63)); }
+static inline int bit_ligado(const uint64_t* v, int i) { return (int)((v[i >> 6] >> (i & 63)) & 1); }
+
+// Bits da palavra que correspondem a quadros existentes
+static inline uint64_t bits_validos(const EstadoRelogio* e, int palavra) {
+    int restantes = e->num_quadros - palavra * 64;
+    return restantes >= 64 ? ~0ULL : (1ULL << restantes) - 1;
+}
+
+static void relogio_registrar_acesso(Politica* p, int quadro) {
+    EstadoRelogio* e = (EstadoRelogio*)p->impl;
+    bit_ligar(e->referencia, quadro);
+    e->ultimo_uso[quadro] = ++e->relogio;
+}
+
+static void relogio_registrar_carga(Politica* p, int quadro) {
+    EstadoRelogio* e = (EstadoRelogio*)p->impl;
+    bit_ligar(e->referencia, quadro);
+    bit_desligar(e->suja, quadro);
+    e->ultimo_uso[quadro] = ++e->relogio;
+}
+
+static void relogio_registrar_escrita(Politica* p, int quadro) {
+    bit_ligar(((EstadoRelogio*)p->impl)->suja, quadro);
+}
+
+// Dá uma volta a partir do ponteiro procurando um quadro com referência 0 e,
+// se 'exigir_suja' >= 0, com o bit sujo igual a ele. Com 'limpar_referencia',
+// os quadros ultrapassados perdem o bit de referência (a "segunda chance").
+// Retorna o quadro encontrado (e avança o ponteiro) ou -1
+static int relogio_varrer(EstadoRelogio* e, int exigir_suja, int limpar_referencia) {
+    int inicio = e->ponteiro;
+    int posicao = inicio;
+
+    // A palavra inicial é visitada duas vezes: bits a partir do ponteiro e, no fim da volta, os anteriores
+    for (int passo = 0; passo <= e->num_palavras; passo++) {
+        int palavra = posicao >> 6;
+        uint64_t validos = bits_validos(e, palavra) & (~0ULL << (posicao & 63));
+        if (passo == e->num_palavras) validos &= (1ULL << (inicio & 63)) - 1;
+
+        uint64_t candidatos = ~e->referencia[palavra] & validos;
+        if (exigir_suja == 0) candidatos &= ~e->suja[palavra];
+        else if (exigir_suja == 1) candidatos &= e->suja[palavra];
+
+        if (candidatos) {
+            int bit = primeiro_bit(candidatos);
+            if (limpar_referencia) e->referencia[palavra] &= ~(validos & ((1ULL << bit) - 1));
+            int vitima = palavra * 64 + bit;
+            e->ponteiro = (vitima + 1) % e->num_quadros;
+            return vitima;
+        }
+        if (limpar_referencia) e->referencia[palavra] &= ~validos;
+        posicao = (palavra + 1) * 64;
+        if (posicao >= e->num_quadros) posicao = 0;
+    }
+    return -1;
+}
+
+// CLOCK: o primeiro quadro sem referência; os referenciados ganham uma segunda chance
+static int escolher_vitima_clock(Politica* p, Frame* memoria_fisica, int num_quadros) {
+    (void)memoria_fisica;
+    (void)num_quadros;
+    EstadoRelogio* e = (EstadoRelogio*)p->impl;
+    int vitima = relogio_varrer(e, -1, 1);
+    // Todos estavam referenciados: após a volta completa, o ponteiro aponta para um quadro sem referência
+    return vitima != -1 ? vitima : relogio_varrer(e, -1, 1);
+}
+
+// Segunda chance melhorada: classes (referência, sujo) em ordem de preferência
+// (0,0) e depois (0,1); a busca por (0,1) limpa as referências, então a
+// segunda rodada sempre encontra uma vítima
+static int escolher_vitima_segunda_chance(Politica* p, Frame* memoria_fisica, int num_quadros) {
+    (void)memoria_fisica;
+    (void)num_quadros;
+    EstadoRelogio* e = (EstadoRelogio*)p->impl;
+    for (;;) {
+        int vitima = relogio_varrer(e, 0, 0);
+        if (vitima != -1) return vitima;
+        vitima = relogio_varrer(e, 1, 1);
+        if (vitima != -1) return vitima;
+    }
+}
+
+// Quadros sem referência examinados no máximo por escolha do WSClock
+#define WSCLOCK_LIMITE_VARREDURA 32
+
+// WSClock: substitui o primeiro quadro limpo fora do conjunto de trabalho
+// (último uso há mais de tau tiques). Um quadro sujo fora do conjunto tem a
+// gravação iniciada ao ser ultrapassado (contada pela simulação por meio de
+// gravar_quadro) e fica limpo, podendo ser escolhido na próxima volta. Quadros
+// referenciados perdem o bit e são pulados; esse custo é pago pelos acessos
+// que o ligaram. Os demais são limitados a WSCLOCK_LIMITE_VARREDURA por
+// escolha: ao atingir o limite, usa o primeiro quadro gravado nesta busca ou,
+// sem ele, o limpo de uso mais antigo, então o custo amortizado é O(1)
+static int escolher_vitima_wsclock(Politica* p, Frame* memoria_fisica, int num_quadros) {
+    (void)memoria_fisica;
+    EstadoRelogio* e = (EstadoRelogio*)p->impl;
+    long agora = e->relogio + 1;
+    int gravado = -1, mais_antigo = -1, examinados = 0;
+
+    // Após uma volta nenhum quadro tem referência, então duas voltas bastam para o limite
+    for (int passo = 0; passo < 2 * num_quadros && examinados < WSCLOCK_LIMITE_VARREDURA; passo++) {
+        int quadro = e->ponteiro;
+        if (++e->ponteiro == num_quadros) e->ponteiro = 0;
+        if (bit_ligado(e->referencia, quadro)) {
+            bit_desligar(e->referencia, quadro);
+            continue;
+        }
+        examinados++;
+        int fora_do_conjunto = agora - e->ultimo_uso[quadro] > e->tau;
+        if (bit_ligado(e->suja, quadro)) {
+            if (fora_do_conjunto) {
+                if (p->gravar_quadro) p->gravar_quadro(p->contexto_gravacao, quadro);
+                bit_desligar(e->suja, quadro);
+                if (gravado == -1) gravado = quadro;
+            }
+        } else if (fora_do_conjunto) {
+            return quadro;
+        } else if (mais_antigo == -1 || e->ultimo_uso[quadro] < e->ultimo_uso[mais_antigo]) {
+            mais_antigo = quadro;
+        }
+    }
+
+    if (gravado != -1) return gravado;
+    if (mais_antigo != -1) return mais_antigo;
+    // Só quadros sujos dentro do conjunto: o da posição do ponteiro é gravado na substituição
+    int vitima = e->ponteiro;
+    if (++e->ponteiro == num_quadros) e->ponteiro = 0;
+    return vitima;
+}
+
+static void destroy_relogio(Politica* p) {
+    EstadoRelogio* e = (EstadoRelogio*)p->impl;
+    free(e->referencia);
+    free(e->suja);
+    free(e->ultimo_uso);
+    free(e);
+    free(p);
+}
+
+static Politica* politica_relogio_create(int num_quadros, int (*escolher_vitima)(Politica*, Frame*, int)) {
+    Politica* p = malloc(sizeof(Politica));
+    EstadoRelogio* e = calloc(1, sizeof(EstadoRelogio));
+    p->impl = e;
+    p->escolher_vitima = escolher_vitima;
+    p->registrar_falta = NULL;
+    p->registrar_acesso = relogio_registrar_acesso;
+    p->registrar_carga = relogio_registrar_carga;
+    p->registrar_escrita = relogio_registrar_escrita;
+    p->gravar_quadro = NULL;
+    p->contexto_gravacao = NULL;
+    p->destroy = destroy_relogio;
+
+    e->num_quadros = num_quadros;
+    e->num_palavras = (num_quadros + 63) / 64;
+    e->referencia = calloc(e->num_palavras, sizeof(uint64_t));
+    e->suja = calloc(e->num_palavras, sizeof(uint64_t));
+    e->ultimo_uso = calloc(num_quadros, sizeof(long));
+    return p;
+}
+
+Politica* politica_clock_create(int num_quadros) {
+    return politica_relogio_create(num_quadros, escolher_vitima_clock);
+}
+
+Politica* politica_segunda_chance_create(int num_quadros) {
+    return politica_relogio_create(num_quadros, escolher_vitima_segunda_chance);
+}
+
+Politica* politica_wsclock_create(int num_quadros, long tau) {
+    Politica* p = politica_relogio_create(num_quadros, escolher_vitima_wsclock);
+    ((EstadoRelogio*)p->impl)->tau = tau;
+    return p;
+}
+
+
+// --- ESTRUTURAS COMUNS DE ARC, 2Q E LIRS ---
+// Essas políticas acompanham páginas, e não só quadros: além das páginas
+// residentes, guardam páginas "fantasmas" (já substituídas) em listas cujo
+// tamanho é limitado pelo número de quadros. Cada página acompanhada ocupa uma
+// entrada de um vetor fixo; o mapa_paginas localiza a entrada de uma página e
+// as listas são encadeadas por índices, sem alocação durante a simulação
+
+// Lista duplamente encadeada de entradas; 'inicio' é o elemento mais novo
+typedef struct {
+    int inicio;
+    int fim;
+    int tamanho;
+} ListaEntradas;
+
+typedef struct {
+    int* anterior;
+    int* proximo;
+} ElosLista;
+
+static void lista_iniciar(ListaEntradas* l) {
+    l->inicio = -1;
+    l->fim = -1;
+    l->tamanho = 0;
+}
+
+static void lista_inserir_inicio(ListaEntradas* l, ElosLista* elos, int no) {
+    elos->anterior[no] = -1;
+    elos->proximo[no] = l->inicio;
+    if (l->inicio != -1) elos->anterior[l->inicio] = no;
+    else l->fim = no;
+    l->inicio = no;
+    l->tamanho++;
+}
+
+static void lista_remover(ListaEntradas* l, ElosLista* elos, int no) {
+    if (elos->anterior[no] != -1) elos->proximo[elos->anterior[no]] = elos->proximo[no];
+    else l->inicio = elos->proximo[no];
+    if (elos->proximo[no] != -1) elos->anterior[elos->proximo[no]] = elos->anterior[no];
+    else l->fim = elos->anterior[no];
+    l->tamanho--;
+}
+
+static void elos_criar(ElosLista* elos, int capacidade) {
+    elos->anterior = malloc(capacidade * sizeof(int));
+    elos->proximo = malloc(capacidade * sizeof(int));
+}
+
+static void elos_destruir(ElosLista* elos) {
+    free(elos->anterior);
+    free(elos->proximo);
+}
+
+typedef struct {
+    MapaPaginas* indice;        // página -> entrada
+    unsigned int* pagina;
+    int* quadro;                // -1 para fantasmas
+    uint8_t* estado;            // lista ou estado da entrada, definido por cada política
+    int* livres;
+    int num_livres;
+    int* entrada_do_quadro;
+} Entradas;
+
+static void entradas_criar(Entradas* t, int capacidade, int num_quadros) {
+    t->indice = mapa_paginas_criar((size_t)capacidade);
+    t->pagina = malloc(capacidade * sizeof(unsigned int));
+    t->quadro = malloc(capacidade * sizeof(int));
+    t->estado = calloc(capacidade, sizeof(uint8_t));
+    t->livres = malloc(capacidade * sizeof(int));
+    t->num_livres = capacidade;
+    for (int i = 0; i < capacidade; i++) t->livres[i] = capacidade - 1 - i;
+    t->entrada_do_quadro = malloc(num_quadros * sizeof(int));
+}
+
+static int entradas_buscar(Entradas* t, unsigned int pagina) {
+    int entrada;
+    return mapa_paginas_buscar(t->indice, pagina, &entrada) ? entrada : -1;
+}
+
+static int entradas_nova(Entradas* t, unsigned int pagina) {
+    int entrada = t->livres[--t->num_livres];
+    t->pagina[entrada] = pagina;
+    t->quadro[entrada] = -1;
+    mapa_paginas_inserir(t->indice, pagina, entrada);
+    return entrada;
+}
+
+static void entradas_liberar(Entradas* t, int entrada) {
+    mapa_paginas_remover(t->indice, t->pagina[entrada]);
+    t->livres[t->num_livres++] = entrada;
+}
+
+// Torna a entrada residente no quadro
+static void entradas_associar(Entradas* t, int entrada, int quadro) {
+    t->quadro[entrada] = quadro;
+    t->entrada_do_quadro[quadro] = entrada;
+}
+
+static void entradas_destruir(Entradas* t) {
+    mapa_paginas_destruir(t->indice);
+    free(t->pagina);
+    free(t->quadro);
+    free(t->estado);
+    free(t->livres);
+    free(t->entrada_do_quadro);
+}
+
+
+// --- ARC: ADAPTIVE REPLACEMENT CACHE ---
+// T1 guarda páginas vistas uma vez recentemente e T2 as vistas ao menos duas
+// vezes; B1 e B2 são os fantasmas das páginas substituídas de cada uma. Uma
+// falta em B1 (ou B2) indica que T1 (ou T2) deveria ser maior e ajusta o
+// alvo 'p' do tamanho de T1. Uma varredura passa só por T1, sem expulsar T2
+
+enum { ARC_T1, ARC_T2, ARC_B1, ARC_B2 };
+
+typedef enum {
+    ARC_FALTA_NOVA,
+    ARC_FALTA_B1,
+    ARC_FALTA_B2
+} CasoFaltaARC;
+
+typedef struct {
+    Entradas entradas;
+    ElosLista elos;
+    ListaEntradas listas[4];
+    int c;
+    int p;
+
+    // Falta em andamento
+    unsigned int pagina_pendente;
+    int entrada_pendente;
+    CasoFaltaARC caso;
+    int descartar_t1; // T1 cheio e B1 vazio: a vítima de T1 não vira fantasma
+} EstadoARC;
+
+static void arc_mover(EstadoARC* e, int entrada, int destino) {
+    lista_remover(&e->listas[e->entradas.estado[entrada]], &e->elos, entrada);
+    e->entradas.estado[entrada] = (uint8_t)destino;
+    lista_inserir_inicio(&e->listas[destino], &e->elos, entrada);
+}
+
+static void arc_descartar_lru(EstadoARC* e, int lista) {
+    int entrada = e->listas[lista].fim;
+    lista_remover(&e->listas[lista], &e->elos, entrada);
+    entradas_liberar(&e->entradas, entrada);
+}
+
+static void arc_registrar_acesso(Politica* p, int quadro) {
+    EstadoARC* e = (EstadoARC*)p->impl;
+    arc_mover(e, e->entradas.entrada_do_quadro[quadro], ARC_T2);
+}
+
+static void arc_registrar_falta(Politica* p, unsigned int pagina) {
+    EstadoARC* e = (EstadoARC*)p->impl;
+    ListaEntradas* l = e->listas;
+    int entrada = entradas_buscar(&e->entradas, pagina);
+
+    e->pagina_pendente = pagina;
+    e->entrada_pendente = entrada;
+    e->descartar_t1 = 0;
+    if (entrada != -1 && e->entradas.estado[entrada] == ARC_B1) {
+        int delta = l[ARC_B2].tamanho / l[ARC_B1].tamanho;
+        e->p += delta > 1 ? delta : 1;
+        if (e->p > e->c) e->p = e->c;
+        e->caso = ARC_FALTA_B1;
+        return;
+    }
+    if (entrada != -1 && e->entradas.estado[entrada] == ARC_B2) {
+        int delta = l[ARC_B1].tamanho / l[ARC_B2].tamanho;
+        e->p -= delta > 1 ? delta : 1;
+        if (e->p < 0) e->p = 0;
+        e->caso = ARC_FALTA_B2;
+        return;
+    }
+
+    // Página nova: mantém |T1| + |B1| <= c e o total <= 2c
+    e->caso = ARC_FALTA_NOVA;
+    int l1 = l[ARC_T1].tamanho + l[ARC_B1].tamanho;
+    int total = l1 + l[ARC_T2].tamanho + l[ARC_B2].tamanho;
+    if (l1 == e->c) {
+        if (l[ARC_T1].tamanho < e->c) arc_descartar_lru(e, ARC_B1);
+        else e->descartar_t1 = 1;
+    } else if (total >= 2 * e->c) {
+        arc_descartar_lru(e, ARC_B2);
+    }
+}
+
+static int escolher_vitima_arc(Politica* p, Frame* memoria_fisica, int num_quadros) {
+    (void)memoria_fisica;
+    (void)num_quadros;
+    EstadoARC* e = (EstadoARC*)p->impl;
+    int t1 = e->listas[ARC_T1].tamanho;
+    int entrada;
+
+    if (e->descartar_t1) {
+        entrada = e->listas[ARC_T1].fim;
+        int quadro = e->entradas.quadro[entrada];
+        lista_remover(&e->listas[ARC_T1], &e->elos, entrada);
+        entradas_liberar(&e->entradas, entrada);
+        return quadro;
+    }
+
+    // REPLACE(x, p)
+    if (t1 >= 1 && ((e->caso == ARC_FALTA_B2 && t1 == e->p) || t1 > e->p || e->listas[ARC_T2].tamanho == 0)) {
+        entrada = e->listas[ARC_T1].fim;
+        arc_mover(e, entrada, ARC_B1);
+    } else {
+        entrada = e->listas[ARC_T2].fim;
+        arc_mover(e, entrada, ARC_B2);
+    }
+    int quadro = e->entradas.quadro[entrada];
+    e->entradas.quadro[entrada] = -1;
+    return quadro;
+}
+
+static void arc_registrar_carga(Politica* p, int quadro) {
+    EstadoARC* e = (EstadoARC*)p->impl;
+    int entrada = e->entrada_pendente;
+    if (e->caso == ARC_FALTA_NOVA) {
+        entrada = entradas_nova(&e->entradas, e->pagina_pendente);
+        e->entradas.estado[entrada] = ARC_T1;
+        lista_inserir_inicio(&e->listas[ARC_T1], &e->elos, entrada);
+    } else {
+        arc_mover(e, entrada, ARC_T2);
+    }
+    entradas_associar(&e->entradas, entrada, quadro);
+}
+
+static void destroy_arc(Politica* p) {
+    EstadoARC* e = (EstadoARC*)p->impl;
+    entradas_destruir(&e->entradas);
+    elos_destruir(&e->elos);
+    free(e);
+    free(p);
+}
+
+Politica* politica_arc_create(int num_quadros) {
+    Politica* p = malloc(sizeof(Politica));
+    EstadoARC* e = calloc(1, sizeof(EstadoARC));
+    p->impl = e;
+    p->registrar_falta = arc_registrar_falta;
+    p->escolher_vitima = escolher_vitima_arc;
+    p->registrar_acesso = arc_registrar_acesso;
+    p->registrar_carga = arc_registrar_carga;
+    p->registrar_escrita = NULL;
+    p->gravar_quadro = NULL;
+    p->contexto_gravacao = NULL;
+    p->destroy = destroy_arc;
+
+    // T1 + T2 + B1 + B2 <= 2c
+    e->c = num_quadros;
+    entradas_criar(&e->entradas, 2 * num_quadros + 1, num_quadros);
+    elos_criar(&e->elos, 2 * num_quadros + 1);
+    for (int i = 0; i < 4; i++) lista_iniciar(&e->listas[i]);
+    return p;
+}
+
+
+// --- 2Q ---
+// Páginas novas entram em A1in (FIFO, ~25% dos quadros). Ao sair de A1in, a
+// página vira fantasma em A1out; só uma nova falta enquanto ela está em A1out
+// a promove para Am (LRU). Páginas acessadas uma única vez, como numa
+// varredura, passam apenas por A1in
+
+enum { Q2_A1IN, Q2_AM, Q2_A1OUT };
+
+typedef struct {
+    Entradas entradas;
+    ElosLista elos;
+    ListaEntradas listas[3];
+    int k_in;
+    int k_out;
+    unsigned int pagina_pendente;
+    int para_am;
+} Estado2Q;
+
+static void q2_registrar_acesso(Politica* p, int quadro) {
+    Estado2Q* e = (Estado2Q*)p->impl;
+    int entrada = e->entradas.entrada_do_quadro[quadro];
+    // Acertos em A1in não mudam nada: ela é uma FIFO
+    if (e->entradas.estado[entrada] == Q2_AM) {
+        lista_remover(&e->listas[Q2_AM], &e->elos, entrada);
+        lista_inserir_inicio(&e->listas[Q2_AM], &e->elos, entrada);
+    }
+}
+
+static void q2_registrar_falta(Politica* p, unsigned int pagina) {
+    Estado2Q* e = (Estado2Q*)p->impl;
+    int entrada = entradas_buscar(&e->entradas, pagina);
+    e->pagina_pendente = pagina;
+    e->para_am = (entrada != -1);
+    if (entrada != -1) {
+        // Só fantasmas podem sofrer falta; a entrada é recriada em Am na carga
+        lista_remover(&e->listas[Q2_A1OUT], &e->elos, entrada);
+        entradas_liberar(&e->entradas, entrada);
+    }
+}
+
+static int escolher_vitima_2q(Politica* p, Frame* memoria_fisica, int num_quadros) {
+    (void)memoria_fisica;
+    (void)num_quadros;
+    Estado2Q* e = (Estado2Q*)p->impl;
+    ListaEntradas* l = e->listas;
+    int entrada, quadro;
+
+    if (l[Q2_A1IN].tamanho > e->k_in || l[Q2_AM].tamanho == 0) {
+        entrada = l[Q2_A1IN].fim;
+        quadro = e->entradas.quadro[entrada];
+        lista_remover(&l[Q2_A1IN], &e->elos, entrada);
+        e->entradas.estado[entrada] = Q2_A1OUT;
+        e->entradas.quadro[entrada] = -1;
+        lista_inserir_inicio(&l[Q2_A1OUT], &e->elos, entrada);
+        if (l[Q2_A1OUT].tamanho > e->k_out) {
+            int antiga = l[Q2_A1OUT].fim;
+            lista_remover(&l[Q2_A1OUT], &e->elos, antiga);
+            entradas_liberar(&e->entradas, antiga);
+        }
+    } else {
+        entrada = l[Q2_AM].fim;
+        quadro = e->entradas.quadro[entrada];
+        lista_remover(&l[Q2_AM], &e->elos, entrada);
+        entradas_liberar(&e->entradas, entrada);
+    }
+    return quadro;
+}
+
+static void q2_registrar_carga(Politica* p, int quadro) {
+    Estado2Q* e = (Estado2Q*)p->impl;
+    int entrada = entradas_nova(&e->entradas, e->pagina_pendente);
+    int destino = e->para_am ? Q2_AM : Q2_A1IN;
+    e->entradas.estado[entrada] = (uint8_t)destino;
+    lista_inserir_inicio(&e->listas[destino], &e->elos, entrada);
+    entradas_associar(&e->entradas, entrada, quadro);
+}
+
+static void destroy_2q(Politica* p) {
+    Estado2Q* e = (Estado2Q*)p->impl;
+    entradas_destruir(&e->entradas);
+    elos_destruir(&e->elos);
+    free(e);
+    free(p);
+}
+
+Politica* politica_2q_create(int num_quadros) {
+    Politica* p = malloc(sizeof(Politica));
+    Estado2Q* e = calloc(1, sizeof(Estado2Q));
+    p->impl = e;
+    p->registrar_falta = q2_registrar_falta;
+    p->escolher_vitima = escolher_vitima_2q;
+    p->registrar_acesso = q2_registrar_acesso;
+    p->registrar_carga = q2_registrar_carga;
+    p->registrar_escrita = NULL;
+    p->gravar_quadro = NULL;
+    p->contexto_gravacao = NULL;
+    p->destroy = destroy_2q;
+
+    // Parâmetros sugeridos pelos autores: Kin = 25% e Kout = 50% dos quadros
+    e->k_in = num_quadros / 4 > 0 ? num_quadros / 4 : 1;
+    e->k_out = num_quadros / 2 > 0 ? num_quadros / 2 : 1;
+    int capacidade = num_quadros + e->k_out + 1;
+    entradas_criar(&e->entradas, capacidade, num_quadros);
+    elos_criar(&e->elos, capacidade);
+    for (int i = 0; i < 3; i++) lista_iniciar(&e->listas[i]);
+    return p;
+}
+
+
+// --- LIRS: LOW INTER-REFERENCE RECENCY SET ---
+// As páginas com menor distância entre reutilizações (LIR) ocupam quase todos
+// os quadros; as demais (HIR) ficam numa pequena fila Q e são as substituídas.
+// A pilha S ordena as páginas por recência e inclui fantasmas HIR, o que
+// permite perceber que uma página HIR voltou antes da LIR mais antiga e
+// promovê-la. O número de fantasmas em S é limitado ao número de quadros
+
+enum { LIRS_LIR, LIRS_HIR, LIRS_HIR_FANTASMA };
+
+typedef struct {
+    Entradas entradas;
+    ElosLista elos_s;
+    ElosLista elos_q;        // fila Q (HIR residentes) e fila de fantasmas, que são disjuntas
+    ListaEntradas s;
+    ListaEntradas q;
+    ListaEntradas fantasmas; // ordem de criação dos fantasmas, para limitá-los
+    uint8_t* em_s;
+    int num_lir;
+    int max_lir;
+    int max_fantasmas;
+    unsigned int pagina_pendente;
+    int entrada_pendente;
+} EstadoLIRS;
+
+static void lirs_mover_topo(EstadoLIRS* e, int entrada) {
+    if (e->em_s[entrada]) lista_remover(&e->s, &e->elos_s, entrada);
+    lista_inserir_inicio(&e->s, &e->elos_s, entrada);
+    e->em_s[entrada] = 1;
+}
+
+// Remove do fundo de S tudo que não é LIR; fantasmas que saem de S são esquecidos
+static void lirs_podar(EstadoLIRS* e) {
+    while (e->s.fim != -1 && e->entradas.estado[e->s.fim] != LIRS_LIR) {
+        int entrada = e->s.fim;
+        lista_remover(&e->s, &e->elos_s, entrada);
+        e->em_s[entrada] = 0;
+        if (e->entradas.estado[entrada] == LIRS_HIR_FANTASMA) {
+            lista_remover(&e->fantasmas, &e->elos_q, entrada);
+            entradas_liberar(&e->entradas, entrada);
+        }
+    }
+}
+
+// Rebaixa as LIR do fundo de S para HIR enquanto houver LIR demais
+static void lirs_ajustar_lir(EstadoLIRS* e) {
+    while (e->num_lir > e->max_lir) {
+        lirs_podar(e);
+        int entrada = e->s.fim;
+        lista_remover(&e->s, &e->elos_s, entrada);
+        e->em_s[entrada] = 0;
+        e->entradas.estado[entrada] = LIRS_HIR;
+        lista_inserir_inicio(&e->q, &e->elos_q, entrada);
+        e->num_lir--;
+    }
+    lirs_podar(e);
+}
+
+static void lirs_registrar_acesso(Politica* p, int quadro) {
+    EstadoLIRS* e = (EstadoLIRS*)p->impl;
+    int entrada = e->entradas.entrada_do_quadro[quadro];
+
+    if (e->entradas.estado[entrada] == LIRS_LIR) {
+        lirs_mover_topo(e, entrada);
+        lirs_podar(e);
+    } else if (e->em_s[entrada]) {
+        // HIR reutilizada antes da LIR mais antiga: vira LIR
+        lirs_mover_topo(e, entrada);
+        lista_remover(&e->q, &e->elos_q, entrada);
+        e->entradas.estado[entrada] = LIRS_LIR;
+        e->num_lir++;
+        lirs_ajustar_lir(e);
+    } else {
+        lirs_mover_topo(e, entrada);
+        lista_remover(&e->q, &e->elos_q, entrada);
+        lista_inserir_inicio(&e->q, &e->elos_q, entrada);
+    }
+}
+
+static void lirs_registrar_falta(Politica* p, unsigned int pagina) {
+    EstadoLIRS* e = (EstadoLIRS*)p->impl;
+    e->pagina_pendente = pagina;
+    e->entrada_pendente = entradas_buscar(&e->entradas, pagina);
+}
+
+static int escolher_vitima_lirs(Politica* p, Frame* memoria_fisica, int num_quadros) {
+    (void)memoria_fisica;
+    (void)num_quadros;
+    EstadoLIRS* e = (EstadoLIRS*)p->impl;
+    int entrada = e->q.fim;
+    int quadro = e->entradas.quadro[entrada];
+    lista_remover(&e->q, &e->elos_q, entrada);
+
+    if (!e->em_s[entrada]) {
+        entradas_liberar(&e->entradas, entrada);
+        return quadro;
+    }
+
+    // Continua em S como fantasma
+    e->entradas.estado[entrada] = LIRS_HIR_FANTASMA;
+    e->entradas.quadro[entrada] = -1;
+    lista_inserir_inicio(&e->fantasmas, &e->elos_q, entrada);
+    if (e->fantasmas.tamanho > e->max_fantasmas) {
+        int antigo = e->fantasmas.fim;
+        lista_remover(&e->fantasmas, &e->elos_q, antigo);
+        lista_remover(&e->s, &e->elos_s, antigo);
+        e->em_s[antigo] = 0;
+        entradas_liberar(&e->entradas, antigo);
+        if (antigo == e->entrada_pendente) e->entrada_pendente = -1;
+    }
+    return quadro;
+}
+
+static void lirs_registrar_carga(Politica* p, int quadro) {
+    EstadoLIRS* e = (EstadoLIRS*)p->impl;
+    int entrada = e->entrada_pendente;
+
+    if (entrada != -1) {
+        // Fantasma ainda em S: a distância de reutilização é menor que a da LIR mais antiga
+        lista_remover(&e->fantasmas, &e->elos_q, entrada);
+        e->entradas.estado[entrada] = LIRS_LIR;
+        e->num_lir++;
+        lirs_mover_topo(e, entrada);
+        entradas_associar(&e->entradas, entrada, quadro);
+        lirs_ajustar_lir(e);
+        return;
+    }
+
+    entrada = entradas_nova(&e->entradas, e->pagina_pendente);
+    e->em_s[entrada] = 0;
+    entradas_associar(&e->entradas, entrada, quadro);
+    lirs_mover_topo(e, entrada);
+    if (e->num_lir < e->max_lir) {
+        // Enquanto o conjunto LIR não está cheio, toda página nova é LIR
+        e->entradas.estado[entrada] = LIRS_LIR;
+        e->num_lir++;
+    } else {
+        e->entradas.estado[entrada] = LIRS_HIR;
+        lista_inserir_inicio(&e->q, &e->elos_q, entrada);
+    }
+}
+
+static void destroy_lirs(Politica* p) {
+    EstadoLIRS* e = (EstadoLIRS*)p->impl;
+    entradas_destruir(&e->entradas);
+    elos_destruir(&e->elos_s);
+    elos_destruir(&e->elos_q);
+    free(e->em_s);
+    free(e);
+    free(p);
+}
+
+Politica* politica_lirs_create(int num_quadros) {
+    Politica* p = malloc(sizeof(Politica));
+    EstadoLIRS* e = calloc(1, sizeof(EstadoLIRS));
+    p->impl = e;
+    p->registrar_falta = lirs_registrar_falta;
+    p->escolher_vitima = escolher_vitima_lirs;
+    p->registrar_acesso = lirs_registrar_acesso;
+    p->registrar_carga = lirs_registrar_carga;
+    p->registrar_escrita = NULL;
+    p->gravar_quadro = NULL;
+    p->contexto_gravacao = NULL;
+    p->destroy = destroy_lirs;
+
+    // HIR residentes: 1% dos quadros (ao menos 1), como sugerido pelos autores
+    int max_hir = num_quadros / 100 > 0 ? num_quadros / 100 : 1;
+    e->max_lir = num_quadros - max_hir;
+    e->max_fantasmas = num_quadros;
+    int capacidade = 2 * num_quadros + 1;
+    entradas_criar(&e->entradas, capacidade, num_quadros);
+    elos_criar(&e->elos_s, capacidade);
+    elos_criar(&e->elos_q, capacidade);
+    e->em_s = calloc(capacidade, sizeof(uint8_t));
+    lista_iniciar(&e->s);
+    lista_iniciar(&e->q);
+    lista_iniciar(&e->fantasmas);
+    return p;
+}
+
+
+// --- OPT (BELADY) ---
+// Política offline: conhece o trace inteiro e substitui a página cujo próximo
+// uso está mais distante. Um passo de trás para frente calcula, para cada
+// acesso, a posição do próximo acesso à mesma página; os quadros ficam num
+// heap de máximo indexado pela posição do próximo uso da página carregada,
+// então cada acesso custa O(log M). Serve de limite inferior de faltas para
+// as demais políticas. A simulação deve receber exatamente os acessos do trace,
+// na ordem: a política conta os acessos pelos próprios ganchos
+
+#define OPT_NUNCA ((size_t)-1)
+
+typedef struct {
+    size_t* proximo_uso;   // por acesso: posição do próximo acesso à mesma página
+    size_t num_acessos;
+    size_t posicao;        // acesso atual
+    size_t posicao_falta;  // acesso que causou a falta em andamento
+
+    size_t* chave;         // por quadro: próximo uso da página carregada
+    int* heap;             // quadros, com o próximo uso mais distante na raiz
+    int* posicao_heap;     // por quadro: índice no heap, ou -1
+    int tamanho_heap;
+} EstadoOPT;
+
+static void opt_trocar(EstadoOPT* e, int i, int j) {
+    int a = e->heap[i], b = e->heap[j];
+    e->heap[i] = b;
+    e->heap[j] = a;
+    e->posicao_heap[b] = i;
+    e->posicao_heap[a] = j;
+}
+
+static void opt_subir(EstadoOPT* e, int i) {
+    while (i > 0) {
+        int pai = (i - 1) / 2;
+        if (e->chave[e->heap[pai]] >= e->chave[e->heap[i]]) break;
+        opt_trocar(e, i, pai);
+        i = pai;
+    }
+}
+
+static void opt_descer(EstadoOPT* e, int i) {
+    for (;;) {
+        int maior = i;
+        int esq = 2 * i + 1, dir = 2 * i + 2;
+        if (esq < e->tamanho_heap && e->chave[e->heap[esq]] > e->chave[e->heap[maior]]) maior = esq;
+        if (dir < e->tamanho_heap && e->chave[e->heap[dir]] > e->chave[e->heap[maior]]) maior = dir;
+        if (maior == i) break;
+        opt_trocar(e, i, maior);
+        i = maior;
+    }
+}
+
+static size_t opt_proximo_uso(EstadoOPT* e, size_t posicao) {
+    return posicao < e->num_acessos ? e->proximo_uso[posicao] : OPT_NUNCA;
+}
+
+// Define a chave do quadro, inserindo-o no heap se necessário
+static void opt_definir_chave(EstadoOPT* e, int quadro, size_t chave) {
+    int i = e->posicao_heap[quadro];
+    if (i == -1) {
+        i = e->tamanho_heap++;
+        e->heap[i] = quadro;
+        e->posicao_heap[quadro] = i;
+        e->chave[quadro] = chave;
+        opt_subir(e, i);
+        return;
+    }
+    size_t anterior = e->chave[quadro];
+    e->chave[quadro] = chave;
+    if (chave > anterior) opt_subir(e, i);
+    else opt_descer(e, i);
+}
+
+static void opt_registrar_acesso(Politica* p, int quadro) {
+    EstadoOPT* e = (EstadoOPT*)p->impl;
+    opt_definir_chave(e, quadro, opt_proximo_uso(e, e->posicao++));
+}
+
+static void opt_registrar_falta(Politica* p, unsigned int pagina) {
+    (void)pagina;
+    EstadoOPT* e = (EstadoOPT*)p->impl;
+    e->posicao_falta = e->posicao++;
+}
+
+static int escolher_vitima_opt(Politica* p, Frame* memoria_fisica, int num_quadros) {
+    (void)memoria_fisica;
+    (void)num_quadros;
+    EstadoOPT* e = (EstadoOPT*)p->impl;
+    return e->heap[0];
+}
+
+static void opt_registrar_carga(Politica* p, int quadro) {
+    EstadoOPT* e = (EstadoOPT*)p->impl;
+    opt_definir_chave(e, quadro, opt_proximo_uso(e, e->posicao_falta));
+}
+
+static void destroy_opt(Politica* p) {
+    EstadoOPT* e = (EstadoOPT*)p->impl;
+    free(e->proximo_uso);
+    free(e->chave);
+    free(e->heap);
+    free(e->posicao_heap);
+    free(e);
+    free(p);
+}
+
+Politica* politica_opt_create(int num_quadros, const unsigned int* enderecos, size_t num_acessos, int deslocamento_s) {
+    Politica* p = malloc(sizeof(Politica));
+    EstadoOPT* e = calloc(1, sizeof(EstadoOPT));
+    p->impl = e;
+    p->registrar_falta = opt_registrar_falta;
+    p->escolher_vitima = escolher_vitima_opt;
+    p->registrar_acesso = opt_registrar_acesso;
+    p->registrar_carga = opt_registrar_carga;
+    p->registrar_escrita = NULL;
+    p->gravar_quadro = NULL;
+    p->contexto_gravacao = NULL;
+    p->destroy = destroy_opt;
+
+    // Passo de trás para frente: 'ultimo' guarda, para cada página, a posição
+    // do acesso seguinte mais próximo já visto. O mapa só numera as páginas;
+    // as posições ficam em size_t, pois o trace pode passar de 2^31 acessos
+    e->num_acessos = num_acessos;
+    e->proximo_uso = malloc((num_acessos > 0 ? num_acessos : 1) * sizeof(size_t));
+    MapaPaginas* ids = mapa_paginas_criar(1024);
+    size_t capacidade = 1024;
+    size_t* ultimo = malloc(capacidade * sizeof(size_t));
+    int num_paginas = 0;
+    for (size_t i = num_acessos; i-- > 0;) {
+        unsigned int pagina = enderecos[i] >> deslocamento_s;
+        int id;
+        if (mapa_paginas_buscar(ids, pagina, &id)) {
+            e->proximo_uso[i] = ultimo[id];
+        } else {
+            id = num_paginas++;
+            mapa_paginas_inserir(ids, pagina, id);
+            if ((size_t)id == capacidade) {
+                capacidade *= 2;
+                ultimo = realloc(ultimo, capacidade * sizeof(size_t));
+            }
+            e->proximo_uso[i] = OPT_NUNCA;
+        }
+        ultimo[id] = i;
+    }
+    mapa_paginas_destruir(ids);
+    free(ultimo);
+
+    e->chave = malloc(num_quadros * sizeof(size_t));
+    e->heap = malloc(num_quadros * sizeof(int));
+    e->posicao_heap = malloc(num_quadros * sizeof(int));
+    for (int i = 0; i < num_quadros; i++) e->posicao_heap[i] = -1;
+    return p;
+}
+
+
+// --- SELEÇÃO POR NOME ---
+
+Politica* politica_create_by_name(const char* nome, int num_quadros, unsigned long long semente) {
+    if (strcmp(nome, "lru") == 0) return politica_lru_create(num_quadros);
+    if (strcmp(nome, "lru_linear") == 0) return politica_simples_create(encontrar_vitima_lru);
+    if (strcmp(nome, "lfu") == 0) return politica_lfu_create(num_quadros);
+    if (strcmp(nome, "lfu_linear") == 0) return politica_simples_create(encontrar_vitima_lfu);
+    if (strcmp(nome, "fifo") == 0) return politica_fifo_create();
+    if (strcmp(nome, "random") == 0) return politica_random_create(semente);
+    if (strcmp(nome, "arc") == 0) return politica_arc_create(num_quadros);
+    if (strcmp(nome, "2q") == 0) return politica_2q_create(num_quadros);
+    if (strcmp(nome, "lirs") == 0) return politica_lirs_create(num_quadros);
+    if (strcmp(nome, "clock") == 0) return politica_clock_create(num_quadros);
+    if (strcmp(nome, "segunda_chance") == 0) return politica_segunda_chance_create(num_quadros);
+    if (strcmp(nome, "wsclock") == 0) {
+        // WSCLOCK_TAU: janela do conjunto de trabalho, em acessos (padrão: 2x o número de quadros)
+        long tau = getenv("WSCLOCK_TAU") ? atol(getenv("WSCLOCK_TAU")) : 2L * num_quadros;
+        return politica_wsclock_create(num_quadros, tau);
+    }
+    return NULL;
 }
\ No newline at end of file
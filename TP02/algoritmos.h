@@ -1,6 +1,7 @@
 #ifndef ALGORITMOS_H
 #define ALGORITMOS_H
 
+#include <stddef.h>
 #include "memoria.h"
 
 // Assinaturas das funções que implementam os algoritmos de substituição
@@ -9,7 +10,33 @@
 
 int encontrar_vitima_lru(Frame* memoria_fisica, int num_quadros);
 int encontrar_vitima_lfu(Frame* memoria_fisica, int num_quadros);
-int encontrar_vitima_fifo(Frame* memoria_fisica, int num_quadros);
-int encontrar_vitima_random(Frame* memoria_fisica, int num_quadros);
+
+// Funções "construtoras" das políticas de substituição (ver memoria.h)
+// Cada política guarda seu próprio estado, sem variáveis globais
+// Política que apenas delega a escolha da vítima a uma das funções acima
+Politica* politica_simples_create(int (*encontrar_vitima)(Frame*, int));
+// LRU com lista de recência intrusiva: escolha da vítima em O(1)
+Politica* politica_lru_create(int num_quadros);
+// LFU com baldes de frequência e desempate por LRU: escolha da vítima em O(1)
+Politica* politica_lfu_create(int num_quadros);
+// FIFO com ponteiro circular
+Politica* politica_fifo_create(void);
+// Aleatória, com gerador próprio inicializado pela semente
+Politica* politica_random_create(unsigned long long semente);
+// CLOCK, segunda chance melhorada (referência + sujo) e WSClock, com bits empacotados
+Politica* politica_clock_create(int num_quadros);
+Politica* politica_segunda_chance_create(int num_quadros);
+// tau: janela do conjunto de trabalho, em acessos
+Politica* politica_wsclock_create(int num_quadros, long tau);
+// Políticas resistentes a varreduras, com listas fantasmas limitadas ao número de quadros
+Politica* politica_arc_create(int num_quadros);
+Politica* politica_2q_create(int num_quadros);
+Politica* politica_lirs_create(int num_quadros);
+// OPT (Belady), offline: recebe os endereços de todo o trace, que deve ser
+// simulado inteiro e na mesma ordem. Não é criada por politica_create_by_name
+Politica* politica_opt_create(int num_quadros, const unsigned int* enderecos, size_t num_acessos, int deslocamento_s);
+
+// Cria a política pelo nome usado na linha de comando. Retorna NULL se o nome for desconhecido
+Politica* politica_create_by_name(const char* nome, int num_quadros, unsigned long long semente);
 
 #endif // ALGORITMOS_H
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "arena.h"
+
+// Alinhamento de todas as alocações (suficiente para ponteiros, inteiros de 64 bits e double)
+#define ARENA_ALINHAMENTO 16
+
+static size_t alinhar(size_t bytes) {
+    return (bytes + ARENA_ALINHAMENTO - 1) & ~(size_t)(ARENA_ALINHAMENTO - 1);
+}
+
+#define ARENA_CABECALHO alinhar(sizeof(ArenaBloco))
+
+static unsigned char* dados_bloco(ArenaBloco* bloco) {
+    return (unsigned char*)bloco + ARENA_CABECALHO;
+}
+
+void arena_iniciar(Arena* arena, size_t tamanho_bloco) {
+    arena->blocos = NULL;
+    arena->tamanho_bloco = alinhar(tamanho_bloco);
+    arena->bytes_reservados = 0;
+    arena->num_blocos = 0;
+}
+
+static ArenaBloco* novo_bloco(Arena* arena, size_t capacidade) {
+    // calloc: a memória distribuída pela arena já sai zerada
+    ArenaBloco* bloco = calloc(1, ARENA_CABECALHO + capacidade);
+    if (!bloco) {
+        perror("Falha ao alocar bloco da arena (memória insuficiente)");
+        exit(EXIT_FAILURE);
+    }
+    bloco->capacidade = capacidade;
+    arena->bytes_reservados += capacidade;
+    arena->num_blocos++;
+    return bloco;
+}
+
+void* arena_alocar(Arena* arena, size_t bytes) {
+    bytes = alinhar(bytes);
+    ArenaBloco* atual = arena->blocos;
+
+    if (bytes > arena->tamanho_bloco) {
+        // Bloco exclusivo, inserido depois do atual para não desperdiçar o espaço que resta nele
+        ArenaBloco* bloco = novo_bloco(arena, bytes);
+        bloco->usado = bytes;
+        if (atual) {
+            bloco->proximo = atual->proximo;
+            atual->proximo = bloco;
+        } else {
+            arena->blocos = bloco;
+        }
+        return dados_bloco(bloco);
+    }
+
+    if (!atual || atual->capacidade - atual->usado < bytes) {
+        atual = novo_bloco(arena, arena->tamanho_bloco);
+        atual->proximo = arena->blocos;
+        arena->blocos = atual;
+    }
+    void* ptr = dados_bloco(atual) + atual->usado;
+    atual->usado += bytes;
+    return ptr;
+}
+
+void arena_liberar_tudo(Arena* arena) {
+    ArenaBloco* bloco = arena->blocos;
+    while (bloco) {
+        ArenaBloco* proximo = bloco->proximo;
+        free(bloco);
+        bloco = proximo;
+    }
+    arena->blocos = NULL;
+    arena->bytes_reservados = 0;
+    arena->num_blocos = 0;
+}
+
+void slab_iniciar(Slab* slab, Arena* arena, size_t tamanho_objeto) {
+    slab->arena = arena;
+    slab->tamanho_objeto = tamanho_objeto < sizeof(void*) ? sizeof(void*) : tamanho_objeto;
+    slab->livres = NULL;
+}
+
+void* slab_alocar(Slab* slab) {
+    if (slab->livres) {
+        void* objeto = slab->livres;
+        slab->livres = *(void**)objeto;
+        return objeto;
+    }
+    return arena_alocar(slab->arena, slab->tamanho_objeto);
+}
+
+void slab_liberar(Slab* slab, void* objeto) {
+    *(void**)objeto = slab->livres;
+    slab->livres = objeto;
+}
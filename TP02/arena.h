@@ -0,0 +1,46 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// Alocador em arena para as estruturas internas das tabelas de páginas. A
+// memória é obtida em blocos grandes e distribuída por incremento de ponteiro;
+// nada é devolvido individualmente à arena, e arena_liberar_tudo libera todos
+// os blocos de uma vez na destruição da tabela. Sobre a arena, um slab recicla
+// objetos de tamanho fixo (ex: nós da tabela invertida) por uma lista de livres
+
+typedef struct ArenaBloco {
+    struct ArenaBloco* proximo;
+    size_t usado;
+    size_t capacidade;
+    // os dados seguem o cabeçalho, alinhados
+} ArenaBloco;
+
+typedef struct {
+    ArenaBloco* blocos;        // bloco atual no início da lista
+    size_t tamanho_bloco;
+    size_t bytes_reservados;   // soma das capacidades dos blocos
+    size_t num_blocos;
+} Arena;
+
+void arena_iniciar(Arena* arena, size_t tamanho_bloco);
+
+// Retorna memória zerada, alinhada para qualquer tipo. Pedidos maiores que o
+// tamanho do bloco recebem um bloco próprio
+void* arena_alocar(Arena* arena, size_t bytes);
+
+void arena_liberar_tudo(Arena* arena);
+
+typedef struct {
+    Arena* arena;
+    size_t tamanho_objeto;
+    void* livres;              // lista ligada pelos próprios objetos livres
+} Slab;
+
+void slab_iniciar(Slab* slab, Arena* arena, size_t tamanho_objeto);
+
+// Objetos reaproveitados da lista de livres não são zerados
+void* slab_alocar(Slab* slab);
+void slab_liberar(Slab* slab, void* objeto);
+
+#endif
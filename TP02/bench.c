@@ -0,0 +1,479 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "memoria.h"
+#include "algoritmos.h"
+#include "pagetable.h"
+#include "tlb.h"
+#include "leitor_trace.h"
+#include "trace_binario.h"
+#include "configuracao.h"
+
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+// Medição de desempenho dos componentes do simulador, separadamente:
+// interpretação do trace, consulta e atualização de cada tabela de páginas,
+// acertos e substituições de cada política e a simulação completa. Usa um
+// trace sintético (80% dos acessos em 20% das páginas) e grava uma linha CSV
+// por medição. Com BENCH_BASE=<csv anterior>, compara os tempos e termina com
+// código 1 se algum ficar mais lento que a tolerância (BENCH_TOLERANCIA, em %).
+// Também termina com código 1 se o custo da substituição de uma política O(1)
+// crescer com o número de quadros.
+// Ciclos e instruções vêm de perf_event_open quando o sistema permite
+
+#define DESLOCAMENTO_BENCH 12
+#define BITS_PAGINA (32 - DESLOCAMENTO_BENCH)
+#define MAX_LINHA 512
+
+static const char* TABELAS[] = {
+    "densa", "densa_virtual", "hierarquica2", "hierarquica3", "densa_compacta",
+    "hierarquica2_compacta", "hierarquica3_compacta", "invertida", "invertida_aberta"
+};
+#define NUM_TABELAS (int)(sizeof(TABELAS) / sizeof(TABELAS[0]))
+
+// A política opt é offline e fica fora: precisa do trace inteiro
+static const char* POLITICAS[] = {
+    "lru", "lru_linear", "lfu", "lfu_linear", "fifo", "random",
+    "clock", "segunda_chance", "wsclock", "arc", "2q", "lirs"
+};
+#define NUM_POLITICAS (int)(sizeof(POLITICAS) / sizeof(POLITICAS[0]))
+
+// --- CONTADORES DE HARDWARE ---
+
+typedef struct {
+    int ciclos;
+    int instrucoes;
+} ContadoresHW;
+
+#ifdef __linux__
+static int abrir_contador(unsigned long long config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static void contadores_abrir(ContadoresHW* c) {
+    c->ciclos = abrir_contador(PERF_COUNT_HW_CPU_CYCLES);
+    c->instrucoes = c->ciclos >= 0 ? abrir_contador(PERF_COUNT_HW_INSTRUCTIONS) : -1;
+    if (c->ciclos < 0) fprintf(stderr, "Aviso: perf_event_open indisponível; ciclos e instruções não serão medidos.\n");
+}
+
+static void contador_iniciar(int fd) {
+    if (fd < 0) return;
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+static long long contador_parar(int fd) {
+    long long valor;
+    if (fd < 0) return -1;
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    return read(fd, &valor, sizeof(valor)) == (ssize_t)sizeof(valor) ? valor : -1;
+}
+
+static void contadores_fechar(ContadoresHW* c) {
+    if (c->ciclos >= 0) close(c->ciclos);
+    if (c->instrucoes >= 0) close(c->instrucoes);
+}
+#else
+static void contadores_abrir(ContadoresHW* c) {
+    c->ciclos = -1;
+    c->instrucoes = -1;
+}
+static void contador_iniciar(int fd) { (void)fd; }
+static long long contador_parar(int fd) { (void)fd; return -1; }
+static void contadores_fechar(ContadoresHW* c) { (void)c; }
+#endif
+
+// --- MEDIÇÕES ---
+
+typedef struct {
+    ContadoresHW hw;
+    double inicio;
+    FILE* csv;
+
+    // Resultados de referência (BENCH_BASE)
+    char** base_chaves;
+    double* base_ns;
+    int num_base;
+    double tolerancia;
+    int regressoes;
+} Bench;
+
+static void carregar_base(Bench* b, const char* nome_arquivo) {
+    FILE* arquivo = fopen(nome_arquivo, "r");
+    if (!arquivo) {
+        perror("Erro ao abrir BENCH_BASE");
+        return;
+    }
+    char linha[MAX_LINHA];
+    int capacidade = 64;
+    b->base_chaves = malloc(capacidade * sizeof(char*));
+    b->base_ns = malloc(capacidade * sizeof(double));
+    while (fgets(linha, sizeof(linha), arquivo)) {
+        // componente,nome,operacao,operacoes,ns_por_op,...
+        char* campos[5];
+        int n = 0;
+        for (char* c = strtok(linha, ",\n"); c && n < 5; c = strtok(NULL, ",\n")) campos[n++] = c;
+        if (n < 5 || strcmp(campos[0], "componente") == 0) continue;
+        if (b->num_base == capacidade) {
+            capacidade *= 2;
+            b->base_chaves = realloc(b->base_chaves, capacidade * sizeof(char*));
+            b->base_ns = realloc(b->base_ns, capacidade * sizeof(double));
+        }
+        char chave[MAX_LINHA];
+        snprintf(chave, sizeof(chave), "%s,%s,%s", campos[0], campos[1], campos[2]);
+        b->base_chaves[b->num_base] = strdup(chave);
+        b->base_ns[b->num_base] = atof(campos[4]);
+        b->num_base++;
+    }
+    fclose(arquivo);
+}
+
+static void medir_inicio(Bench* b) {
+    contador_iniciar(b->hw.ciclos);
+    contador_iniciar(b->hw.instrucoes);
+    b->inicio = tempo_em_segundos();
+}
+
+// Registra a medição e retorna o tempo por operação, em ns
+static double medir_fim(Bench* b, const char* componente, const char* nome, const char* operacao, unsigned long operacoes) {
+    double segundos = tempo_em_segundos() - b->inicio;
+    long long ciclos = contador_parar(b->hw.ciclos);
+    long long instrucoes = contador_parar(b->hw.instrucoes);
+    double ns = segundos * 1e9 / (double)operacoes;
+
+    fprintf(b->csv, "%s,%s,%s,%lu,%.3f,%.3f", componente, nome, operacao, operacoes, ns,
+            (double)operacoes / 1e6 / segundos);
+    if (ciclos >= 0) fprintf(b->csv, ",%.2f", (double)ciclos / (double)operacoes);
+    else fprintf(b->csv, ",");
+    if (instrucoes >= 0) fprintf(b->csv, ",%.2f\n", (double)instrucoes / (double)operacoes);
+    else fprintf(b->csv, ",\n");
+
+    printf("  %-10s %-26s %-13s %9.2f ns/op %9.2f milhões/s", componente, nome, operacao, ns,
+           (double)operacoes / 1e6 / segundos);
+    if (ciclos >= 0) printf(" %8.1f ciclos/op", (double)ciclos / (double)operacoes);
+
+    char chave[MAX_LINHA];
+    snprintf(chave, sizeof(chave), "%s,%s,%s", componente, nome, operacao);
+    for (int i = 0; i < b->num_base; i++) {
+        if (strcmp(b->base_chaves[i], chave) != 0 || b->base_ns[i] <= 0.0) continue;
+        double variacao = 100.0 * (ns - b->base_ns[i]) / b->base_ns[i];
+        printf(" (%+.1f%%)", variacao);
+        if (variacao > b->tolerancia) {
+            printf(" REGRESSÃO");
+            b->regressoes++;
+        }
+        break;
+    }
+    printf("\n");
+    return ns;
+}
+
+// --- TRACE SINTÉTICO ---
+
+static uint64_t proximo_aleatorio(uint64_t* estado) {
+    uint64_t x = *estado;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *estado = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+// Espalha identificadores densos pelo espaço de páginas (multiplicação por
+// um ímpar é uma bijeção módulo 2^BITS_PAGINA)
+static unsigned int pagina_do_id(unsigned long id) {
+    return (unsigned int)((id * 2654435761UL) & ((1UL << BITS_PAGINA) - 1));
+}
+
+// Identificadores de página dos acessos: 80% dos acessos nos 20% primeiros ids
+static unsigned long* gerar_ids(unsigned long num_acessos, unsigned long num_paginas, uint64_t* estado) {
+    unsigned long* ids = malloc(num_acessos * sizeof(unsigned long));
+    unsigned long quentes = num_paginas / 5 > 0 ? num_paginas / 5 : 1;
+    for (unsigned long i = 0; i < num_acessos; i++) {
+        uint64_t r = proximo_aleatorio(estado);
+        ids[i] = (r % 10 < 8) ? (r >> 8) % quentes : (r >> 8) % num_paginas;
+    }
+    return ids;
+}
+
+// --- COMPONENTES ---
+
+static int escrever_traces(const char* nome_texto, const char* nome_binario, const unsigned long* ids,
+                           unsigned long num_acessos) {
+    FILE* texto = fopen(nome_texto, "w");
+    EscritorTraceBinario* binario = escritor_binario_abrir(nome_binario);
+    if (!texto || !binario) {
+        perror("Erro ao criar o trace sintético");
+        if (texto) fclose(texto);
+        if (binario) escritor_binario_fechar(binario);
+        return 0;
+    }
+    for (unsigned long i = 0; i < num_acessos; i++) {
+        unsigned int endereco = (pagina_do_id(ids[i]) << DESLOCAMENTO_BENCH) | (unsigned int)(i & 0xFFC);
+        char tipo = (i % 4 == 0) ? 'W' : 'R';
+        fprintf(texto, "%08x %c\n", endereco, tipo);
+        escritor_binario_adicionar(binario, endereco, tipo);
+    }
+    fclose(texto);
+    return escritor_binario_fechar(binario);
+}
+
+static void bench_leitura(Bench* b, const char* nome, const char* nome_arquivo) {
+    unsigned int enderecos[4096];
+    char tipos[4096];
+    unsigned long total = 0, soma = 0;
+    size_t lidos;
+
+    medir_inicio(b);
+    LeitorTrace* leitor = leitor_trace_abrir(nome_arquivo);
+    if (!leitor) {
+        perror("Erro ao abrir o trace sintético");
+        return;
+    }
+    while ((lidos = leitor_trace_lote(leitor, enderecos, tipos, 4096)) > 0) {
+        soma += enderecos[lidos - 1];
+        total += lidos;
+    }
+    leitor_trace_fechar(leitor);
+    medir_fim(b, "leitura", nome, "interpretar", total > 0 ? total : 1);
+    if (soma == 1) printf("%lu\n", soma); // impede que o laço seja descartado
+}
+
+static void bench_tabela(Bench* b, const char* nome, PageTable* pt, const unsigned long* ids,
+                         unsigned long num_acessos, int num_quadros) {
+    unsigned int* mapeadas = malloc(num_quadros * sizeof(unsigned int));
+    unsigned int* consultas = malloc(num_acessos * sizeof(unsigned int));
+    for (int f = 0; f < num_quadros; f++) {
+        mapeadas[f] = pagina_do_id((unsigned long)f);
+        pt->update(pt, mapeadas[f], f);
+    }
+    // Consultas: 90% em páginas mapeadas, 10% em páginas ausentes
+    for (unsigned long i = 0; i < num_acessos; i++) {
+        unsigned long id = (i % 10 != 0) ? ids[i] % (unsigned long)num_quadros : ids[i] + (unsigned long)num_quadros;
+        consultas[i] = pagina_do_id(id);
+    }
+
+    long soma = 0;
+    medir_inicio(b);
+    for (unsigned long i = 0; i < num_acessos; i++) {
+        int custo = 0;
+        soma += pt->lookup(pt, consultas[i], &custo) + custo;
+    }
+    medir_fim(b, "tabela", nome, "consulta", num_acessos);
+
+    // Substituições: desmapeia a página do quadro e mapeia uma página nova,
+    // como na falta de página (duas atualizações por operação)
+    unsigned long ids_livres = (1UL << BITS_PAGINA) - (unsigned long)num_quadros;
+    medir_inicio(b);
+    for (unsigned long i = 0; i < num_acessos; i++) {
+        int f = (int)(i % (unsigned long)num_quadros);
+        pt->update(pt, mapeadas[f], -1);
+        mapeadas[f] = pagina_do_id((unsigned long)num_quadros + i % ids_livres);
+        pt->update(pt, mapeadas[f], f);
+    }
+    medir_fim(b, "tabela", nome, "atualizacao", num_acessos);
+
+    if (soma == 1) printf("%ld\n", soma);
+    free(mapeadas);
+    free(consultas);
+}
+
+// Retorna o tempo por substituição, em ns. 'rotulo' distingue as medições no CSV
+static double bench_politica(Bench* b, const char* nome, const char* rotulo, const unsigned long* ids,
+                             unsigned long num_acessos, int num_quadros) {
+    Politica* p = politica_create_by_name(nome, num_quadros, 42);
+    Frame* quadros = calloc(num_quadros, sizeof(Frame));
+    long agora = 0;
+
+    for (int f = 0; f < num_quadros; f++) {
+        agora++;
+        if (p->registrar_falta) p->registrar_falta(p, (unsigned int)f);
+        quadros[f].ocupado = 1;
+        quadros[f].numero_pagina_virtual = (unsigned int)f;
+        quadros[f].ultimo_acesso = agora;
+        quadros[f].frequencia = 1;
+        if (p->registrar_carga) p->registrar_carga(p, f);
+    }
+
+    // Acertos em quadros escolhidos pela distribuição do trace
+    medir_inicio(b);
+    for (unsigned long i = 0; i < num_acessos; i++) {
+        int f = (int)(ids[i] % (unsigned long)num_quadros);
+        agora++;
+        quadros[f].ultimo_acesso = agora;
+        quadros[f].frequencia++;
+        if (p->registrar_acesso) p->registrar_acesso(p, f);
+    }
+    medir_fim(b, "politica", rotulo, "acerto", num_acessos);
+
+    // Substituições: páginas sempre novas, cada uma custa uma escolha de vítima
+    // e uma carga. Uma em cada quatro é escrita, para exercitar o bit sujo
+    medir_inicio(b);
+    for (unsigned long i = 0; i < num_acessos; i++) {
+        unsigned int pagina = (unsigned int)num_quadros + (unsigned int)i;
+        agora++;
+        if (p->registrar_falta) p->registrar_falta(p, pagina);
+        int f = p->escolher_vitima(p, quadros, num_quadros);
+        quadros[f].numero_pagina_virtual = pagina;
+        quadros[f].ultimo_acesso = agora;
+        quadros[f].frequencia = 1;
+        quadros[f].suja = (i % 4 == 0);
+        if (p->registrar_carga) p->registrar_carga(p, f);
+        if (i % 4 == 0 && p->registrar_escrita) p->registrar_escrita(p, f);
+    }
+    double ns = medir_fim(b, "politica", rotulo, "substituicao", num_acessos);
+
+    p->destroy(p);
+    free(quadros);
+    return ns;
+}
+
+// Políticas com escolha de vítima em O(1) (amortizado): o tempo por
+// substituição não deve crescer com o número de quadros. Compara a medição com
+// 'num_quadros' (ns_por_politica, na ordem de POLITICAS) com uma feita com
+// FATOR_ESCALA vezes mais quadros; uma razão acima de LIMITE_ESCALA (uma
+// varredura linear daria perto de FATOR_ESCALA) conta como regressão. A
+// segunda chance melhorada fica de fora: procurar a classe (0,0) pode exigir
+// uma volta inteira do relógio (em palavras de 64 quadros)
+#define FATOR_ESCALA 16
+#define LIMITE_ESCALA 4.0
+
+static const char* POLITICAS_O1[] = {
+    "lru", "lfu", "fifo", "random", "clock", "wsclock", "arc", "2q", "lirs"
+};
+#define NUM_POLITICAS_O1 (int)(sizeof(POLITICAS_O1) / sizeof(POLITICAS_O1[0]))
+
+static void verificar_escala(Bench* b, const unsigned long* ids, unsigned long num_acessos, int num_quadros,
+                             const double* ns_por_politica) {
+    char rotulo[MAX_LINHA];
+    int quadros_grande = num_quadros * FATOR_ESCALA;
+    for (int i = 0; i < NUM_POLITICAS_O1; i++) {
+        int p = 0;
+        while (strcmp(POLITICAS[p], POLITICAS_O1[i]) != 0) p++;
+        snprintf(rotulo, sizeof(rotulo), "%s@%d", POLITICAS_O1[i], quadros_grande);
+        double ns = bench_politica(b, POLITICAS_O1[i], rotulo, ids, num_acessos, quadros_grande);
+        double razao = ns_por_politica[p] > 0.0 ? ns / ns_por_politica[p] : 0.0;
+        printf("  %-10s %-26s razão %.2f com %dx quadros%s\n", "escala", POLITICAS_O1[i], razao, FATOR_ESCALA,
+               razao > LIMITE_ESCALA ? " NÃO É O(1)" : "");
+        if (razao > LIMITE_ESCALA) b->regressoes++;
+    }
+}
+
+static void bench_simulacao(Bench* b, const char* nome, PageTable* pt, Politica* politica,
+                            const unsigned int* paginas, unsigned long num_acessos, int num_quadros) {
+    Simulacao* sim = simulacao_criar(num_quadros, pt, politica);
+    medir_inicio(b);
+    for (unsigned long i = 0; i < num_acessos; i++) {
+        simulacao_acessar(sim, paginas[i], (i % 4 == 0) ? 'W' : 'R');
+    }
+    medir_fim(b, "simulacao", nome, "acesso", num_acessos);
+    simulacao_destruir(sim);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 5) {
+        fprintf(stderr, "Uso: %s [num_acessos] [num_paginas] [num_quadros] [saida.csv]\n", argv[0]);
+        fprintf(stderr, "  Padrão: 1048576 acessos, 65536 páginas, 1024 quadros, bench.csv\n");
+        fprintf(stderr, "  BENCH_BASE=<csv> compara com uma execução anterior (BENCH_TOLERANCIA em %%, padrão 10)\n");
+        return 1;
+    }
+    unsigned long num_acessos = argc > 1 ? strtoul(argv[1], NULL, 10) : 1UL << 20;
+    unsigned long num_paginas = argc > 2 ? strtoul(argv[2], NULL, 10) : 1UL << 16;
+    int num_quadros = argc > 3 ? atoi(argv[3]) : 1024;
+    const char* nome_csv = argc > 4 ? argv[4] : "bench.csv";
+    if (num_acessos == 0 || num_paginas == 0 || num_quadros <= 0 || num_paginas > (1UL << BITS_PAGINA) / 2 ||
+        (unsigned long)num_quadros > num_paginas) {
+        fprintf(stderr, "Erro: parâmetros inválidos (é preciso 0 < quadros <= páginas <= %lu).\n",
+                (1UL << BITS_PAGINA) / 2);
+        return 1;
+    }
+
+    Bench b;
+    memset(&b, 0, sizeof(b));
+    b.csv = fopen(nome_csv, "w");
+    if (!b.csv) {
+        perror("Erro ao criar o arquivo de resultados");
+        return 1;
+    }
+    fprintf(b.csv, "componente,nome,operacao,operacoes,ns_por_op,milhoes_ops_s,ciclos_por_op,instrucoes_por_op\n");
+    b.tolerancia = getenv("BENCH_TOLERANCIA") ? atof(getenv("BENCH_TOLERANCIA")) : 10.0;
+    if (getenv("BENCH_BASE")) carregar_base(&b, getenv("BENCH_BASE"));
+    contadores_abrir(&b.hw);
+
+    uint64_t estado = 0x9E3779B97F4A7C15ULL;
+    unsigned long* ids = gerar_ids(num_acessos, num_paginas, &estado);
+    unsigned int* paginas = malloc(num_acessos * sizeof(unsigned int));
+    for (unsigned long i = 0; i < num_acessos; i++) paginas[i] = pagina_do_id(ids[i]);
+    printf("Trace sintético: %lu acessos, %lu páginas, %d quadros de %d KB\n", num_acessos, num_paginas,
+           num_quadros, 1 << (DESLOCAMENTO_BENCH - 10));
+
+    const char* dir = getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp";
+    char nome_texto[MAX_LINHA], nome_binario[MAX_LINHA];
+    snprintf(nome_texto, sizeof(nome_texto), "%s/bench_simulador_%d.log", dir, (int)getpid());
+    snprintf(nome_binario, sizeof(nome_binario), "%s/bench_simulador_%d.bin", dir, (int)getpid());
+    if (escrever_traces(nome_texto, nome_binario, ids, num_acessos)) {
+        bench_leitura(&b, "texto", nome_texto);
+        bench_leitura(&b, "binario", nome_binario);
+    }
+    unlink(nome_texto);
+    unlink(nome_binario);
+
+    for (int t = 0; t < NUM_TABELAS; t++) {
+        PageTable* pt = pagetable_create_by_name(TABELAS[t], DESLOCAMENTO_BENCH, num_quadros);
+        bench_tabela(&b, TABELAS[t], pt, ids, num_acessos, num_quadros);
+        pt->destroy(pt);
+    }
+    PageTable* com_tlb = pagetable_tlb_create(pagetable_create_by_name("hierarquica2", DESLOCAMENTO_BENCH, num_quadros),
+                                              64, 4, TLB_SUBST_LRU, 42);
+    bench_tabela(&b, "hierarquica2+tlb64", com_tlb, ids, num_acessos, num_quadros);
+    com_tlb->destroy(com_tlb);
+
+    double ns_substituicao[NUM_POLITICAS];
+    for (int p = 0; p < NUM_POLITICAS; p++) {
+        ns_substituicao[p] = bench_politica(&b, POLITICAS[p], POLITICAS[p], ids, num_acessos, num_quadros);
+    }
+    verificar_escala(&b, ids, num_acessos, num_quadros, ns_substituicao);
+
+    // Simulação completa: cada tabela com LRU e cada política com hierarquica2
+    char nome[MAX_LINHA];
+    for (int t = 0; t < NUM_TABELAS; t++) {
+        snprintf(nome, sizeof(nome), "%s/lru", TABELAS[t]);
+        bench_simulacao(&b, nome, pagetable_create_by_name(TABELAS[t], DESLOCAMENTO_BENCH, num_quadros),
+                        politica_lru_create(num_quadros), paginas, num_acessos, num_quadros);
+    }
+    for (int p = 0; p < NUM_POLITICAS; p++) {
+        if (strcmp(POLITICAS[p], "lru") == 0) continue; // já medida acima
+        snprintf(nome, sizeof(nome), "hierarquica2/%s", POLITICAS[p]);
+        bench_simulacao(&b, nome, pagetable_create_by_name("hierarquica2", DESLOCAMENTO_BENCH, num_quadros),
+                        politica_create_by_name(POLITICAS[p], num_quadros, 42), paginas, num_acessos, num_quadros);
+    }
+
+    printf("Resultados gravados em %s\n", nome_csv);
+    if (b.num_base > 0) printf("Comparação com %s: %d regressões acima de %.1f%%\n", getenv("BENCH_BASE"),
+                               b.regressoes, b.tolerancia);
+
+    contadores_fechar(&b.hw);
+    fclose(b.csv);
+    for (int i = 0; i < b.num_base; i++) free(b.base_chaves[i]);
+    free(b.base_chaves);
+    free(b.base_ns);
+    free(ids);
+    free(paginas);
+    return b.regressoes > 0 ? 1 : 0;
+}
@@ -0,0 +1,154 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "configuracao.h"
+#include "algoritmos.h"
+#include "tlb.h"
+#include "paginas_grandes.h"
+
+int calcular_deslocamento(int tam_pagina_kb) {
+    int tmp = tam_pagina_kb * 1024;
+    int s = 0;
+    while (tmp > 1) {
+        tmp = tmp >> 1;
+        s++;
+    }
+    return s;
+}
+
+double tempo_em_segundos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int comparar_com_opt(void) {
+    const char* valor = getenv("COMPARAR_OPT");
+    return valor != NULL && *valor != '\0' && strcmp(valor, "0") != 0;
+}
+
+static int eh_opt(const char* algoritmo) {
+    return strcmp(algoritmo, "opt") == 0;
+}
+
+int configuracao_precisa_trace(const char* algoritmo) {
+    return eh_opt(algoritmo) || comparar_com_opt();
+}
+
+// A política "opt" não é criada por nome: ela precisa do trace inteiro
+static Politica* criar_politica(Configuracao* c, const char* algoritmo, int num_quadros, unsigned long long semente) {
+    if (!eh_opt(algoritmo)) return politica_create_by_name(algoritmo, num_quadros, semente);
+    if (c->trace == NULL) return NULL;
+    return politica_opt_create(num_quadros, c->trace->enderecos, c->trace->num_acessos, c->deslocamento_s);
+}
+
+// Cria a simulação da configuração. Retorna 0 (com mensagem de erro) se algum parâmetro for inválido
+int criar_configuracao(Configuracao* c, unsigned long long semente) {
+    if (c->tam_pagina_kb <= 0 || c->tam_memoria_kb < c->tam_pagina_kb) {
+        fprintf(stderr, "Erro: tamanhos inválidos (página %d KB, memória %d KB).\n", c->tam_pagina_kb, c->tam_memoria_kb);
+        return 0;
+    }
+    c->deslocamento_s = calcular_deslocamento(c->tam_pagina_kb);
+    int num_quadros = (c->tam_memoria_kb * 1024) / (c->tam_pagina_kb * 1024);
+
+    if (eh_opt(c->algoritmo) && c->trace == NULL) {
+        fprintf(stderr, "Erro: a política 'opt' precisa do trace carregado em memória.\n");
+        return 0;
+    }
+    Politica* politica = criar_politica(c, c->algoritmo, num_quadros, semente);
+    if (politica == NULL) {
+        fprintf(stderr, "Erro: Algoritmo de substituição '%s' desconhecido.\n", c->algoritmo);
+        return 0;
+    }
+    PageTable* pt = pagetable_create_by_name(c->tabela, c->deslocamento_s, num_quadros);
+    if (pt == NULL) {
+        fprintf(stderr, "Erro: Tipo de tabela de páginas '%s' (de PAGE_TABLE_TYPE) desconhecido.\n", c->tabela);
+        politica->destroy(politica);
+        return 0;
+    }
+    if (!pagetable_tlb_do_ambiente(&pt, semente)) {
+        pt->destroy(pt);
+        politica->destroy(politica);
+        return 0;
+    }
+    PaginasGrandes* grandes;
+    if (!paginas_grandes_do_ambiente(&grandes, c->tabela, c->tam_pagina_kb, num_quadros, semente)) {
+        pt->destroy(pt);
+        politica->destroy(politica);
+        return 0;
+    }
+    if (grandes && configuracao_precisa_trace(c->algoritmo)) {
+        // As cargas das promoções não fazem parte do trace que a política conhece
+        fprintf(stderr, "Erro: a política 'opt' e COMPARAR_OPT não podem ser usados com páginas grandes (HUGE_PAGE_KB).\n");
+        paginas_grandes_destruir(grandes);
+        pt->destroy(pt);
+        politica->destroy(politica);
+        return 0;
+    }
+    c->sim = simulacao_criar(num_quadros, pt, politica);
+    simulacao_usar_paginas_grandes(c->sim, grandes);
+
+    // A referência só conta faltas e escritas; a tabela não tem TLB
+    c->sim_opt = NULL;
+    if (c->trace && comparar_com_opt() && !eh_opt(c->algoritmo)) {
+        c->sim_opt = simulacao_criar(num_quadros, pagetable_create_by_name(c->tabela, c->deslocamento_s, num_quadros),
+                                     criar_politica(c, "opt", num_quadros, semente));
+    }
+    return 1;
+}
+
+void configuracao_simular_trace(Configuracao* c) {
+    const TraceCarregado* trace = c->trace;
+    Simulacao* sims[2] = {c->sim, c->sim_opt};
+    for (int s = 0; s < 2 && sims[s]; s++) {
+        for (size_t i = 0; i < trace->num_acessos; i++) {
+            simulacao_acessar(sims[s], trace->enderecos[i] >> c->deslocamento_s, trace->tipos[i]);
+        }
+    }
+}
+
+void configuracao_destruir(Configuracao* c) {
+    simulacao_destruir(c->sim);
+    simulacao_destruir(c->sim_opt);
+    c->sim = NULL;
+    c->sim_opt = NULL;
+}
+
+// Distância até o ótimo: quantas faltas a mais que o OPT nos mesmos quadros
+static void imprimir_comparacao_opt(FILE* out, Simulacao* sim, Simulacao* sim_opt) {
+    long excesso = (long)sim->paginas_lidas - (long)sim_opt->paginas_lidas;
+    fprintf(out, "Comparação com o ótimo (OPT):\n");
+    fprintf(out, "  Page faults do OPT: %u\n", sim_opt->paginas_lidas);
+    fprintf(out, "  Páginas escritas do OPT: %u\n", sim_opt->paginas_escritas);
+    if (sim_opt->paginas_lidas > 0) {
+        fprintf(out, "  Faltas acima do ótimo: %ld (%.2f%%)\n", excesso,
+                100.0 * (double)excesso / (double)sim_opt->paginas_lidas);
+    }
+}
+
+void imprimir_relatorio(FILE* out, const char* nome_arquivo, Configuracao* c) {
+    fprintf(out, "\n--- Relatório Final ---\n");
+    fprintf(out, "Configuração:\n");
+    fprintf(out, "  Arquivo de entrada: %s\n", nome_arquivo);
+    fprintf(out, "  Tamanho da memória: %d KB\n", c->tam_memoria_kb);
+    fprintf(out, "  Tamanho das páginas: %d KB\n", c->tam_pagina_kb);
+    fprintf(out, "  Algoritmo de substituição: %s\n", c->algoritmo);
+    fprintf(out, "  Estrutura da Tabela de Páginas: %s", c->tabela);
+    if (c->origem_tabela) fprintf(out, " (via %s)", c->origem_tabela);
+    fprintf(out, "\n\n");
+    simulacao_imprimir_resultados(c->sim, out);
+#ifdef INSTRUMENTACAO
+    char rotulo[512];
+    snprintf(rotulo, sizeof(rotulo), "%s;%s;%dKB;%dKB;%s", nome_arquivo, c->algoritmo, c->tam_pagina_kb,
+             c->tam_memoria_kb, c->tabela);
+    instrumentacao_exportar(c->sim->instr, rotulo);
+#endif
+    if (c->sim_opt) {
+        fprintf(out, "\n");
+        imprimir_comparacao_opt(out, c->sim, c->sim_opt);
+    }
+    fprintf(out, "\n");
+}
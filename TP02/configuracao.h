@@ -0,0 +1,50 @@
+#ifndef CONFIGURACAO_H
+#define CONFIGURACAO_H
+
+#include <stdio.h>
+#include "memoria.h"
+#include "leitor_trace.h"
+
+// Funções compartilhadas pelos modos de execução do simulador
+// (execução única, varredura e lote)
+
+// Uma configuração simulada: parâmetros e a simulação correspondente
+typedef struct {
+    const char* algoritmo;
+    const char* tabela;
+    // De onde veio a tabela, para o relatório (NULL: padrão do simulador)
+    const char* origem_tabela;
+    int tam_pagina_kb;
+    int tam_memoria_kb;
+    int deslocamento_s;
+    Simulacao* sim;
+
+    // Trace completo em memória, exigido pela política offline "opt" e pela
+    // comparação com o ótimo (COMPARAR_OPT). NULL quando o trace é lido em fluxo
+    const TraceCarregado* trace;
+    // Simulação de referência com OPT nos mesmos quadros, se COMPARAR_OPT estiver definida
+    Simulacao* sim_opt;
+} Configuracao;
+
+// Número de bits de deslocamento dentro da página
+int calcular_deslocamento(int tam_pagina_kb);
+
+// Relógio monotônico em segundos, para medir tempos de execução
+double tempo_em_segundos(void);
+
+// Cria a simulação da configuração. Retorna 0 (com mensagem de erro) se algum parâmetro for inválido
+int criar_configuracao(Configuracao* c, unsigned long long semente);
+
+// Indica se a configuração com o algoritmo dado precisa do trace carregado
+// em memória (política "opt" ou variável COMPARAR_OPT definida)
+int configuracao_precisa_trace(const char* algoritmo);
+
+// Simula todos os acessos de c->trace, inclusive na simulação de referência
+void configuracao_simular_trace(Configuracao* c);
+
+void configuracao_destruir(Configuracao* c);
+
+// Imprime o relatório final de uma configuração já simulada
+void imprimir_relatorio(FILE* out, const char* nome_arquivo, Configuracao* c);
+
+#endif
\ No newline at end of file
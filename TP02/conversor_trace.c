@@ -0,0 +1,91 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "leitor_trace.h"
+#include "trace_binario.h"
+
+// Converte um log texto ("%08x R|W") para o formato binário compacto e vice-versa.
+// O sentido da conversão é decidido pelo formato do arquivo de entrada
+
+#define TAM_LOTE 4096
+
+static int texto_para_binario(LeitorTrace* leitor, const char* nome_saida, unsigned long* total) {
+    EscritorTraceBinario* escritor = escritor_binario_abrir(nome_saida);
+    if (!escritor) {
+        perror("Erro ao criar o arquivo de saída");
+        return 0;
+    }
+
+    unsigned int enderecos[TAM_LOTE];
+    char tipos[TAM_LOTE];
+    size_t lidos;
+    int ok = 1;
+    while (ok && (lidos = leitor_trace_lote(leitor, enderecos, tipos, TAM_LOTE)) > 0) {
+        for (size_t i = 0; i < lidos && ok; i++) {
+            ok = escritor_binario_adicionar(escritor, enderecos[i], tipos[i]);
+        }
+        *total += lidos;
+    }
+
+    if (!escritor_binario_fechar(escritor)) ok = 0;
+    if (!ok) perror("Erro ao gravar o arquivo de saída");
+    return ok;
+}
+
+static int binario_para_texto(LeitorTrace* leitor, const char* nome_saida, unsigned long* total) {
+    FILE* saida = fopen(nome_saida, "w");
+    if (!saida) {
+        perror("Erro ao criar o arquivo de saída");
+        return 0;
+    }
+
+    static const char hex[] = "0123456789abcdef";
+    char linha[11 * TAM_LOTE];
+    unsigned int enderecos[TAM_LOTE];
+    char tipos[TAM_LOTE];
+    size_t lidos;
+    int ok = 1;
+    while (ok && (lidos = leitor_trace_lote(leitor, enderecos, tipos, TAM_LOTE)) > 0) {
+        char* p = linha;
+        for (size_t i = 0; i < lidos; i++) {
+            for (int d = 7; d >= 0; d--) {
+                *p++ = hex[(enderecos[i] >> (4 * d)) & 0xF];
+            }
+            *p++ = ' ';
+            *p++ = tipos[i];
+            *p++ = '\n';
+        }
+        ok = fwrite(linha, 1, (size_t)(p - linha), saida) == (size_t)(p - linha);
+        *total += lidos;
+    }
+
+    if (fclose(saida) != 0) ok = 0;
+    if (!ok) perror("Erro ao gravar o arquivo de saída");
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "Uso: %s <entrada> <saida>\n", argv[0]);
+        fprintf(stderr, "  Log texto na entrada gera um trace binário; trace binário gera um log texto.\n");
+        return 1;
+    }
+
+    LeitorTrace* leitor = leitor_trace_abrir(argv[1]);
+    if (!leitor) {
+        perror("Erro ao abrir o arquivo de entrada");
+        return 1;
+    }
+
+    unsigned long total = 0;
+    int binario = leitor->binario;
+    int ok = binario ? binario_para_texto(leitor, argv[2], &total)
+                     : texto_para_binario(leitor, argv[2], &total);
+    size_t bytes_entrada = leitor_trace_bytes_lidos(leitor);
+    leitor_trace_fechar(leitor);
+    if (!ok) return 1;
+
+    printf("Convertidos %lu acessos (%s -> %s), %zu bytes lidos.\n", total,
+           binario ? "binário" : "texto", binario ? "texto" : "binário", bytes_entrada);
+    return 0;
+}
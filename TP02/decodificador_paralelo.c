@@ -0,0 +1,178 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include "decodificador_paralelo.h"
+#include "trace_binario.h"
+#include "pool_tarefas.h"
+#include "configuracao.h"
+
+// Tamanho aproximado de um trecho: 1 MB de texto (~95 mil linhas) ou 4 blocos binários
+#define BYTES_POR_TRECHO (1 << 20)
+#define BLOCOS_POR_TRECHO 4
+
+// Trechos em voo por thread auxiliar
+#define TRECHOS_POR_THREAD 2
+
+int decodificador_threads_padrao(void) {
+    return pool_threads_padrao() - 1;
+}
+
+// Delimita o próximo trecho a partir de d->proximo_inicio e devolve quantos
+// acessos ele pode conter no máximo. Chamada com a trava obtida
+static size_t delimitar_trecho(DecodificadorParalelo* d, const char** fim_trecho) {
+    const char* inicio = d->proximo_inicio;
+    const char* fim = d->leitor->fim;
+
+    if (d->leitor->binario) {
+        // Agrupa blocos inteiros. Como cada acesso ocupa ao menos um byte, um
+        // bloco tem no máximo tantos acessos quanto bytes
+        const unsigned char* p = (const unsigned char*)inicio;
+        size_t capacidade = 0;
+        for (int b = 0; b < BLOCOS_POR_TRECHO && fim - (const char*)p >= TRACE_BIN_TAM_CABECALHO_BLOCO; b++) {
+            uint32_t acessos = trace_bin_ler_u32(p);
+            uint32_t tamanho = trace_bin_ler_u32(p + 4);
+            p += TRACE_BIN_TAM_CABECALHO_BLOCO;
+            if ((size_t)(fim - (const char*)p) < tamanho) {
+                // Bloco truncado: o trecho vai até o fim e a decodificação avisa
+                p = (const unsigned char*)fim;
+                break;
+            }
+            capacidade += acessos < tamanho ? acessos : tamanho;
+            p += tamanho;
+        }
+        if (fim - (const char*)p < TRACE_BIN_TAM_CABECALHO_BLOCO) p = (const unsigned char*)fim;
+        *fim_trecho = (const char*)p;
+        return capacidade;
+    }
+
+    // Texto: corta no primeiro '\n' depois de BYTES_POR_TRECHO
+    const char* corte = (size_t)(fim - inicio) > BYTES_POR_TRECHO ? inicio + BYTES_POR_TRECHO : fim;
+    if (corte < fim) {
+        const char* quebra = memchr(corte, '\n', (size_t)(fim - corte));
+        corte = quebra ? quebra + 1 : fim;
+    }
+    *fim_trecho = corte;
+    // Cada acesso ocupa ao menos dois bytes ("0R")
+    return (size_t)(corte - inicio) / 2 + 1;
+}
+
+static void* trabalhar(void* arg) {
+    DecodificadorParalelo* d = (DecodificadorParalelo*)arg;
+    double tempo = 0.0;
+
+    pthread_mutex_lock(&d->trava);
+    for (;;) {
+        // Espera a posição da fila do próximo trecho ser liberada
+        while (!d->encerrar && d->proximo_inicio < d->leitor->fim &&
+               d->fila[d->proximo_trecho % d->tamanho_fila].estado != TRECHO_LIVRE) {
+            pthread_cond_wait(&d->mudou, &d->trava);
+        }
+        if (d->encerrar || d->proximo_inicio >= d->leitor->fim) break;
+
+        TrechoDecodificado* trecho = &d->fila[d->proximo_trecho % d->tamanho_fila];
+        const char* fim_trecho;
+        size_t capacidade = delimitar_trecho(d, &fim_trecho);
+        trecho->estado = TRECHO_DECODIFICANDO;
+        trecho->inicio = d->proximo_inicio;
+        trecho->fim = fim_trecho;
+        d->proximo_inicio = fim_trecho;
+        d->proximo_trecho++;
+        pthread_mutex_unlock(&d->trava);
+
+        double t0 = tempo_em_segundos();
+        if (capacidade > trecho->capacidade) {
+            free(trecho->acessos);
+            trecho->acessos = malloc(capacidade * sizeof(uint32_t));
+            trecho->capacidade = capacidade;
+        }
+        trecho->num_acessos = leitor_trace_decodificar_trecho(trecho->inicio, trecho->fim, d->leitor->binario,
+                                                              d->deslocamento_s, trecho->acessos,
+                                                              &trecho->completo);
+        tempo += tempo_em_segundos() - t0;
+
+        pthread_mutex_lock(&d->trava);
+        trecho->estado = TRECHO_PRONTO;
+        pthread_cond_broadcast(&d->mudou);
+    }
+    d->tempo_decodificacao += tempo;
+    pthread_mutex_unlock(&d->trava);
+    return NULL;
+}
+
+DecodificadorParalelo* decodificador_paralelo_criar(LeitorTrace* leitor, int deslocamento_s, int num_threads) {
+    if (leitor->modo != LEITOR_MMAP || num_threads < 1) return NULL;
+
+    DecodificadorParalelo* d = calloc(1, sizeof(DecodificadorParalelo));
+    d->leitor = leitor;
+    d->deslocamento_s = deslocamento_s;
+    d->num_threads = num_threads;
+    d->tamanho_fila = TRECHOS_POR_THREAD * num_threads + 1;
+    d->fila = calloc(d->tamanho_fila, sizeof(TrechoDecodificado));
+    d->proximo_inicio = leitor->atual;
+    pthread_mutex_init(&d->trava, NULL);
+    pthread_cond_init(&d->mudou, NULL);
+
+    d->threads = malloc(num_threads * sizeof(pthread_t));
+    for (int t = 0; t < num_threads; t++) {
+        pthread_create(&d->threads[t], NULL, trabalhar, d);
+    }
+    return d;
+}
+
+size_t decodificador_paralelo_proximo(DecodificadorParalelo* d, const uint32_t** acessos) {
+    pthread_mutex_lock(&d->trava);
+    for (;;) {
+        // Devolve à fila o trecho entregue na chamada anterior
+        if (d->entregue) {
+            d->entregue->estado = TRECHO_LIVRE;
+            d->entregue = NULL;
+            pthread_cond_broadcast(&d->mudou);
+        }
+        if (d->encerrar) break;
+
+        TrechoDecodificado* trecho = &d->fila[d->trecho_entrega % d->tamanho_fila];
+        double t0 = tempo_em_segundos();
+        while (trecho->estado != TRECHO_PRONTO &&
+               !(d->trecho_entrega == d->proximo_trecho && d->proximo_inicio >= d->leitor->fim)) {
+            pthread_cond_wait(&d->mudou, &d->trava);
+        }
+        d->tempo_espera += tempo_em_segundos() - t0;
+        if (trecho->estado != TRECHO_PRONTO) break; // todos os trechos já foram entregues
+
+        d->entregue = trecho;
+        d->trecho_entrega++;
+        d->leitor->atual = trecho->fim;
+        if (!trecho->completo) {
+            // Como no leitor sequencial, a leitura para na primeira linha mal formada
+            d->leitor->atual = d->leitor->fim;
+            d->encerrar = 1;
+            pthread_cond_broadcast(&d->mudou);
+        }
+        if (trecho->num_acessos > 0) {
+            *acessos = trecho->acessos;
+            pthread_mutex_unlock(&d->trava);
+            return trecho->num_acessos;
+        }
+    }
+    pthread_mutex_unlock(&d->trava);
+    return 0;
+}
+
+void decodificador_paralelo_destruir(DecodificadorParalelo* d) {
+    if (d == NULL) return;
+    pthread_mutex_lock(&d->trava);
+    d->encerrar = 1;
+    pthread_cond_broadcast(&d->mudou);
+    pthread_mutex_unlock(&d->trava);
+    for (int t = 0; t < d->num_threads; t++) {
+        pthread_join(d->threads[t], NULL);
+    }
+
+    for (int i = 0; i < d->tamanho_fila; i++) free(d->fila[i].acessos);
+    pthread_mutex_destroy(&d->trava);
+    pthread_cond_destroy(&d->mudou);
+    free(d->fila);
+    free(d->threads);
+    free(d);
+}
@@ -0,0 +1,68 @@
+#ifndef DECODIFICADOR_PARALELO_H
+#define DECODIFICADOR_PARALELO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "leitor_trace.h"
+
+// Decodificação paralela de um trace mapeado em memória. O arquivo é dividido
+// em trechos (em fronteiras de linha no texto, de bloco no binário) que threads
+// auxiliares convertem em acessos empacotados (ver ACESSO_EMPACOTAR) já com o
+// deslocamento da página aplicado. Os trechos prontos são entregues em ordem,
+// por uma fila circular limitada, a quem consome os acessos, de modo que a
+// decodificação se sobrepõe à simulação sem que o trace inteiro seja carregado
+
+typedef enum {
+    TRECHO_LIVRE,
+    TRECHO_DECODIFICANDO,
+    TRECHO_PRONTO
+} EstadoTrecho;
+
+typedef struct {
+    EstadoTrecho estado;
+    uint32_t* acessos;
+    size_t capacidade;
+    size_t num_acessos;
+    int completo;              // 0 se o trecho terminou em uma linha mal formada
+    const char* inicio;
+    const char* fim;
+} TrechoDecodificado;
+
+typedef struct {
+    LeitorTrace* leitor;
+    int deslocamento_s;
+    int num_threads;
+    pthread_t* threads;
+
+    pthread_mutex_t trava;
+    pthread_cond_t mudou;
+    TrechoDecodificado* fila;
+    int tamanho_fila;
+
+    const char* proximo_inicio;   // início do próximo trecho a ser distribuído
+    unsigned long proximo_trecho; // número do próximo trecho a ser distribuído
+    unsigned long trecho_entrega; // número do próximo trecho a ser entregue
+    TrechoDecodificado* entregue; // trecho em uso por quem consome
+    int encerrar;
+
+    double tempo_decodificacao;   // soma dos tempos das threads auxiliares
+    double tempo_espera;          // tempo em que quem consome esperou por trechos
+} DecodificadorParalelo;
+
+// Número de threads auxiliares padrão: uma a menos que pool_threads_padrao(),
+// já que a thread principal fica com a simulação. 0 desativa a decodificação paralela
+int decodificador_threads_padrao(void);
+
+// Inicia as threads sobre um leitor em modo mmap. Retorna NULL se o leitor não
+// estiver em modo mmap ou se num_threads < 1
+DecodificadorParalelo* decodificador_paralelo_criar(LeitorTrace* leitor, int deslocamento_s, int num_threads);
+
+// Entrega o próximo trecho, em ordem. Retorna o número de acessos (0 no fim do trace).
+// O vetor entregue é válido até a próxima chamada
+size_t decodificador_paralelo_proximo(DecodificadorParalelo* d, const uint32_t** acessos);
+
+// Encerra as threads (mesmo que o trace não tenha sido lido até o fim)
+void decodificador_paralelo_destruir(DecodificadorParalelo* d);
+
+#endif
@@ -0,0 +1,180 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "instrumentacao.h"
+
+#define JANELA_PADRAO 100000
+
+// Serializa a gravação dos arquivos entre as tarefas do modo lote
+static pthread_mutex_t trava_exportacao = PTHREAD_MUTEX_INITIALIZER;
+
+Instrumentacao* instrumentacao_criar(void) {
+    Instrumentacao* instr = calloc(1, sizeof(Instrumentacao));
+    const char* janela = getenv("INSTR_JANELA");
+    instr->tamanho_janela = janela && atol(janela) > 0 ? (unsigned long)atol(janela) : JANELA_PADRAO;
+    return instr;
+}
+
+void instrumentacao_fechar_janela(Instrumentacao* instr, unsigned long acessos, unsigned long faltas,
+                                  unsigned long escritas, unsigned long custo) {
+    if (acessos == instr->inicio.acessos) return;
+    if (instr->num_janelas == instr->capacidade_janelas) {
+        instr->capacidade_janelas = instr->capacidade_janelas ? instr->capacidade_janelas * 2 : 64;
+        instr->janelas = realloc(instr->janelas, instr->capacidade_janelas * sizeof(JanelaInstr));
+    }
+    JanelaInstr* j = &instr->janelas[instr->num_janelas++];
+    j->acessos = acessos - instr->inicio.acessos;
+    j->faltas = faltas - instr->inicio.faltas;
+    j->escritas = escritas - instr->inicio.escritas;
+    j->custo = custo - instr->inicio.custo;
+    instr->inicio.acessos = acessos;
+    instr->inicio.faltas = faltas;
+    instr->inicio.escritas = escritas;
+    instr->inicio.custo = custo;
+}
+
+// Menor valor v tal que ao menos 'fracao' das amostras são <= v
+static unsigned long percentil(const Histograma* h, double fracao) {
+    unsigned long alvo = (unsigned long)(fracao * (double)h->total), acumulado = 0;
+    for (unsigned long v = 0; v <= HISTOGRAMA_MAX; v++) {
+        acumulado += h->contagem[v];
+        if (acumulado > alvo || acumulado == h->total) return v;
+    }
+    return HISTOGRAMA_MAX;
+}
+
+static void imprimir_histograma(const Histograma* h, FILE* out, const char* nome) {
+    if (h->total == 0) {
+        fprintf(out, "  %s: sem amostras\n", nome);
+        return;
+    }
+    fprintf(out, "  %s: média %.3f, mediana %lu, p99 %lu, máximo %lu\n", nome,
+            (double)h->soma / (double)h->total, percentil(h, 0.5), percentil(h, 0.99), h->maximo);
+    for (int v = 0; v <= HISTOGRAMA_MAX; v++) {
+        if (h->contagem[v] == 0) continue;
+        fprintf(out, "    %s%2d: %12lu (%6.2f%%)\n", v == HISTOGRAMA_MAX ? ">=" : "  ", v, h->contagem[v],
+                100.0 * (double)h->contagem[v] / (double)h->total);
+    }
+}
+
+void instrumentacao_imprimir(Instrumentacao* instr, FILE* out) {
+    fprintf(out, "\nInstrumentação:\n");
+    imprimir_histograma(&instr->custo_consulta, out, "Custo por consulta");
+    imprimir_histograma(&instr->sondagens, out, "Comprimento das sondagens");
+
+    if (instr->num_janelas == 0) return;
+    double min = 1.0, max = 0.0;
+    size_t pior = 0;
+    for (size_t i = 0; i < instr->num_janelas; i++) {
+        double taxa = (double)instr->janelas[i].faltas / (double)instr->janelas[i].acessos;
+        if (taxa < min) min = taxa;
+        if (taxa > max) {
+            max = taxa;
+            pior = i;
+        }
+    }
+    fprintf(out, "  Janelas de %lu acessos: %zu; taxa de faltas entre %.2f%% e %.2f%% (pior: janela %zu)\n",
+            instr->tamanho_janela, instr->num_janelas, 100.0 * min, 100.0 * max, pior);
+}
+
+// Escreve 'texto' como campo CSV entre aspas, duplicando as aspas internas (RFC 4180)
+static void exportar_campo_csv(FILE* f, const char* texto) {
+    fputc('"', f);
+    for (const char* c = texto; *c; c++) {
+        if (*c == '"') fputc('"', f);
+        fputc(*c, f);
+    }
+    fputc('"', f);
+}
+
+static void exportar_histograma_csv(FILE* f, const char* rotulo, const char* metrica, const Histograma* h) {
+    for (int v = 0; v <= HISTOGRAMA_MAX; v++) {
+        if (h->contagem[v] == 0) continue;
+        exportar_campo_csv(f, rotulo);
+        fprintf(f, ",%s,%d,%lu\n", metrica, v, h->contagem[v]);
+    }
+}
+
+static void exportar_csv(Instrumentacao* instr, const char* rotulo, FILE* f) {
+    fseek(f, 0, SEEK_END);
+    if (ftell(f) == 0) fprintf(f, "configuracao,metrica,indice,valor\n");
+    exportar_histograma_csv(f, rotulo, "custo_consulta", &instr->custo_consulta);
+    exportar_histograma_csv(f, rotulo, "sondagens", &instr->sondagens);
+    for (size_t i = 0; i < instr->num_janelas; i++) {
+        JanelaInstr* j = &instr->janelas[i];
+        exportar_campo_csv(f, rotulo);
+        fprintf(f, ",janela_acessos,%zu,%lu\n", i, j->acessos);
+        exportar_campo_csv(f, rotulo);
+        fprintf(f, ",janela_faltas,%zu,%lu\n", i, j->faltas);
+        exportar_campo_csv(f, rotulo);
+        fprintf(f, ",janela_escritas,%zu,%lu\n", i, j->escritas);
+        exportar_campo_csv(f, rotulo);
+        fprintf(f, ",janela_custo_medio,%zu,%.4f\n", i, (double)j->custo / (double)j->acessos);
+    }
+}
+
+static void exportar_histograma_json(FILE* f, const char* nome, const Histograma* h) {
+    fprintf(f, "\"%s\":{\"amostras\":%lu,\"soma\":%lu,\"maximo\":%lu,\"contagem\":[", nome, h->total, h->soma, h->maximo);
+    for (int v = 0; v <= HISTOGRAMA_MAX; v++) fprintf(f, "%s%lu", v ? "," : "", h->contagem[v]);
+    fprintf(f, "]}");
+}
+
+// Escreve 'texto' como string JSON, escapando aspas, barras e caracteres de controle
+static void exportar_string_json(FILE* f, const char* texto) {
+    fputc('"', f);
+    for (const unsigned char* c = (const unsigned char*)texto; *c; c++) {
+        if (*c == '"' || *c == '\\') fprintf(f, "\\%c", *c);
+        else if (*c < 0x20) fprintf(f, "\\u%04x", *c);
+        else fputc(*c, f);
+    }
+    fputc('"', f);
+}
+
+static void exportar_json(Instrumentacao* instr, const char* rotulo, FILE* f) {
+    fprintf(f, "{\"configuracao\":");
+    exportar_string_json(f, rotulo);
+    fprintf(f, ",\"tamanho_janela\":%lu,", instr->tamanho_janela);
+    exportar_histograma_json(f, "custo_consulta", &instr->custo_consulta);
+    fprintf(f, ",");
+    exportar_histograma_json(f, "sondagens", &instr->sondagens);
+    fprintf(f, ",\"janelas\":[");
+    for (size_t i = 0; i < instr->num_janelas; i++) {
+        JanelaInstr* j = &instr->janelas[i];
+        fprintf(f, "%s{\"acessos\":%lu,\"faltas\":%lu,\"escritas\":%lu,\"custo\":%lu}", i ? "," : "",
+                j->acessos, j->faltas, j->escritas, j->custo);
+    }
+    fprintf(f, "]}\n");
+}
+
+void instrumentacao_exportar(Instrumentacao* instr, const char* rotulo) {
+    const char* nome_csv = getenv("INSTR_CSV");
+    const char* nome_json = getenv("INSTR_JSON");
+    if (!nome_csv && !nome_json) return;
+
+    pthread_mutex_lock(&trava_exportacao);
+    if (nome_csv) {
+        FILE* f = fopen(nome_csv, "a");
+        if (f) {
+            exportar_csv(instr, rotulo, f);
+            fclose(f);
+        } else {
+            perror("Erro ao gravar INSTR_CSV");
+        }
+    }
+    if (nome_json) {
+        FILE* f = fopen(nome_json, "a");
+        if (f) {
+            exportar_json(instr, rotulo, f);
+            fclose(f);
+        } else {
+            perror("Erro ao gravar INSTR_JSON");
+        }
+    }
+    pthread_mutex_unlock(&trava_exportacao);
+}
+
+void instrumentacao_destruir(Instrumentacao* instr) {
+    if (instr == NULL) return;
+    free(instr->janelas);
+    free(instr);
+}
@@ -0,0 +1,87 @@
+#ifndef INSTRUMENTACAO_H
+#define INSTRUMENTACAO_H
+
+#include <stdio.h>
+
+// Instrumentação do caminho crítico, compilada só com -DINSTRUMENTACAO
+// ("make instrumentado"): histograma do custo de cada consulta à tabela de
+// páginas, distribuição do comprimento das sondagens nas tabelas com hash
+// (nós percorridos na invertida, grupos na invertida_aberta) e faltas,
+// escritas e custo médio por janela fixa de acessos (INSTR_JANELA, padrão
+// 100000). Sem a macro, os pontos de coleta (INSTR_*) não geram código.
+//
+// Além do resumo no relatório, os dados podem ser exportados para
+// INSTR_CSV (formato longo: configuracao,metrica,indice,valor) e INSTR_JSON
+// (um objeto por configuração, uma linha cada). Os dois arquivos recebem as
+// configurações em sequência, então varreduras e lotes podem usar um só arquivo
+
+#define HISTOGRAMA_MAX 64 // o último balde acumula valores >= HISTOGRAMA_MAX
+
+typedef struct Histograma {
+    unsigned long contagem[HISTOGRAMA_MAX + 1];
+    unsigned long total;
+    unsigned long soma;
+    unsigned long maximo;
+} Histograma;
+
+static inline void histograma_registrar(Histograma* h, unsigned long valor) {
+    h->contagem[valor < HISTOGRAMA_MAX ? valor : HISTOGRAMA_MAX]++;
+    h->total++;
+    h->soma += valor;
+    if (valor > h->maximo) h->maximo = valor;
+}
+
+typedef struct {
+    unsigned long acessos;
+    unsigned long faltas;
+    unsigned long escritas;
+    unsigned long custo;
+} JanelaInstr;
+
+typedef struct {
+    Histograma custo_consulta;
+    Histograma sondagens;
+
+    unsigned long tamanho_janela;
+    JanelaInstr* janelas;
+    size_t num_janelas;
+    size_t capacidade_janelas;
+
+    // Contadores da simulação no início da janela atual
+    JanelaInstr inicio;
+} Instrumentacao;
+
+Instrumentacao* instrumentacao_criar(void);
+
+// Fecha a janela atual com os contadores acumulados da simulação
+void instrumentacao_fechar_janela(Instrumentacao* instr, unsigned long acessos, unsigned long faltas,
+                                  unsigned long escritas, unsigned long custo);
+
+// Resumo para o relatório
+void instrumentacao_imprimir(Instrumentacao* instr, FILE* out);
+
+// Grava os dados em INSTR_CSV e INSTR_JSON, se definidas. Pode ser chamada por várias threads
+void instrumentacao_exportar(Instrumentacao* instr, const char* rotulo);
+
+void instrumentacao_destruir(Instrumentacao* instr);
+
+#ifdef INSTRUMENTACAO
+// Custo total da consulta de um acesso
+#define INSTR_CONSULTA(sim, custo) histograma_registrar(&(sim)->instr->custo_consulta, (unsigned long)(custo))
+// Comprimento de uma sondagem na tabela 'pt'
+#define INSTR_SONDAGEM(pt, n) \
+    do { if ((pt)->sondagens) histograma_registrar((pt)->sondagens, (unsigned long)(n)); } while (0)
+// Início de um acesso: fecha a janela se ela estiver completa
+#define INSTR_ACESSO(sim)                                                                              \
+    do {                                                                                               \
+        if ((sim)->total_acessos - (sim)->instr->inicio.acessos == (sim)->instr->tamanho_janela)       \
+            instrumentacao_fechar_janela((sim)->instr, (sim)->total_acessos, (sim)->paginas_lidas,     \
+                                         (sim)->paginas_escritas, (sim)->total_lookup_cost);          \
+    } while (0)
+#else
+#define INSTR_CONSULTA(sim, custo) ((void)0)
+#define INSTR_SONDAGEM(pt, n) ((void)0)
+#define INSTR_ACESSO(sim) ((void)0)
+#endif
+
+#endif
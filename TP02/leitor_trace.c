@@ -0,0 +1,493 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "leitor_trace.h"
+#include "trace_binario.h"
+
+// --- DECODIFICADOR HEXADECIMAL (SWAR) ---
+// As linhas geradas pelo gerador_log têm formato fixo "%08x R\n". Os 8 dígitos
+// são carregados em uma palavra de 64 bits e validados/convertidos de uma vez,
+// byte a byte em paralelo dentro do registrador, sem desvios por caractere
+
+#define SWAR_01 0x0101010101010101ULL
+#define SWAR_80 0x8080808080808080ULL
+
+// Marca com 0x80 os bytes de x que estão no intervalo aberto (m, n). Requer bytes < 0x80
+#define SWAR_ENTRE(x, m, n) \
+    (((SWAR_01 * (127 + (n)) - ((x) & SWAR_01 * 127)) & ~(x) & \
+      (((x) & SWAR_01 * 127) + SWAR_01 * (127 - (m)))) & SWAR_80)
+
+static int swar_hex8(const char* p, unsigned int* valor) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+
+    // Validação: todos os bytes devem ser [0-9a-fA-F]. Só as letras passam para
+    // minúsculas: com o bit 0x20 ligado, os bytes 0x10-0x19 virariam '0'-'9'
+    uint64_t minusc = v | (SWAR_01 * 0x20);
+    uint64_t digitos = SWAR_ENTRE(v, '0' - 1, '9' + 1);
+    uint64_t letras = SWAR_ENTRE(minusc, 'a' - 1, 'f' + 1);
+    if (((digitos | letras) != SWAR_80) || (v & SWAR_80)) return 0;
+
+    // Conversão: '0'-'9' -> 0-9 e 'a'-'f'/'A'-'F' -> 10-15 (bit 6 indica letra)
+    uint64_t x = (v & (SWAR_01 * 0x0F)) + ((v >> 6) & SWAR_01) * 9;
+
+    // Junta os nibbles: o primeiro caractere (byte menos significativo) é o mais significativo
+    x = ((x << 4) | (x >> 8)) & 0x00FF00FF00FF00FFULL;
+    x = ((x << 8) | (x >> 16)) & 0x0000FFFF0000FFFFULL;
+    x = ((x << 16) | (x >> 32)) & 0x00000000FFFFFFFFULL;
+    *valor = (unsigned int)x;
+    return 1;
+#else
+    unsigned int resultado = 0;
+    for (int i = 0; i < 8; i++) {
+        unsigned char c = (unsigned char)p[i];
+        unsigned int d;
+        if (c >= '0' && c <= '9') d = c - '0';
+        else if ((c | 0x20) >= 'a' && (c | 0x20) <= 'f') d = (c | 0x20) - 'a' + 10;
+        else return 0;
+        resultado = (resultado << 4) | d;
+    }
+    *valor = resultado;
+    return 1;
+#endif
+}
+
+static int eh_espaco(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+static int valor_hex(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Caminho genérico, equivalente a fscanf("%x %c") sobre a região mapeada.
+// Usado apenas quando a linha não segue o formato fixo
+static int ler_linha_generica(LeitorTrace* leitor, unsigned int* endereco, char* tipo_acesso) {
+    const char* p = leitor->atual;
+    const char* fim = leitor->fim;
+
+    while (p < fim && eh_espaco(*p)) p++;
+    if (p + 1 < fim && p[0] == '0' && (p[1] == 'x' || p[1] == 'X') &&
+        p + 2 < fim && valor_hex(p[2]) >= 0) {
+        p += 2;
+    }
+
+    unsigned int valor = 0;
+    int digitos = 0;
+    while (p < fim && valor_hex(*p) >= 0) {
+        valor = (valor << 4) | (unsigned int)valor_hex(*p);
+        p++;
+        digitos++;
+    }
+    if (digitos == 0) {
+        leitor->atual = fim;
+        return 0;
+    }
+
+    while (p < fim && eh_espaco(*p)) p++;
+    if (p >= fim) {
+        leitor->atual = fim;
+        return 0;
+    }
+
+    *endereco = valor;
+    *tipo_acesso = *p++;
+    leitor->atual = p;
+    return 1;
+}
+
+static inline int ler_linha_mmap(LeitorTrace* leitor, unsigned int* endereco, char* tipo_acesso) {
+    const char* p = leitor->atual;
+
+    // Caminho rápido: "XXXXXXXX T" seguido opcionalmente de '\n'
+    if (leitor->fim - p >= 10 && p[8] == ' ' && !eh_espaco(p[9]) && swar_hex8(p, endereco)) {
+        *tipo_acesso = p[9];
+        p += 10;
+        p += (p < leitor->fim && *p == '\n');
+        leitor->atual = p;
+        return 1;
+    }
+    return ler_linha_generica(leitor, endereco, tipo_acesso);
+}
+
+
+// --- LEITURA EM FLUXO (STDIN, PIPES) ---
+
+// Buffer inicial do modo fluxo; dobra se uma linha ou bloco binário não couber
+#define TAM_BUFFER_FLUXO (4 << 20)
+
+// Copia [manter, fim_dados) para o início do buffer e o completa com read(2)
+// até enchê-lo ou chegar ao fim do fluxo
+static void encher_fluxo(LeitorTrace* leitor, const char* manter) {
+    size_t mantidos = (size_t)(leitor->fim_dados - manter);
+    leitor->bytes_descartados += (size_t)(manter - leitor->buffer);
+    memmove(leitor->buffer, manter, mantidos);
+    if (mantidos == leitor->capacidade_buffer) {
+        char* maior = realloc(leitor->buffer, leitor->capacidade_buffer * 2);
+        if (maior) {
+            leitor->buffer = maior;
+            leitor->capacidade_buffer *= 2;
+        } else {
+            perror("Erro ao ampliar o buffer do trace");
+            leitor->fim_fluxo = 1;
+        }
+    }
+
+    size_t n = mantidos;
+    while (n < leitor->capacidade_buffer && !leitor->fim_fluxo) {
+        ssize_t lidos = read(leitor->fd, leitor->buffer + n, leitor->capacidade_buffer - n);
+        if (lidos > 0) {
+            n += (size_t)lidos;
+        } else if (lidos == 0) {
+            leitor->fim_fluxo = 1;
+        } else if (errno != EINTR) {
+            perror("Erro ao ler o trace");
+            leitor->fim_fluxo = 1;
+        }
+    }
+    leitor->inicio = leitor->buffer;
+    leitor->atual = leitor->buffer;
+    leitor->fim = leitor->buffer;
+    leitor->fim_dados = leitor->buffer + n;
+}
+
+// Garante ao menos n bytes a partir de 'atual'. Retorna 0 se o fluxo acabar antes
+static int garantir_fluxo(LeitorTrace* leitor, size_t n) {
+    while ((size_t)(leitor->fim_dados - leitor->atual) < n) {
+        if (leitor->fim_fluxo) return 0;
+        encher_fluxo(leitor, leitor->atual);
+    }
+    return 1;
+}
+
+// Lê mais dados e delimita em [inicio, fim) as linhas completas; a linha
+// parcial do fim fica para a próxima leitura. Retorna 0 no fim do fluxo
+static int recarregar_texto(LeitorTrace* leitor) {
+    const char* ultima;
+    for (;;) {
+        if (leitor->fim_fluxo && leitor->fim == leitor->fim_dados) return 0;
+        encher_fluxo(leitor, leitor->fim);
+        ultima = leitor->fim_dados;
+        if (leitor->fim_fluxo) break;
+        while (ultima > leitor->inicio && ultima[-1] != '\n') ultima--;
+        if (ultima > leitor->inicio) break;
+        // Nenhuma linha completa no buffer cheio: a próxima leitura o dobra
+    }
+    leitor->fim = ultima;
+    return leitor->atual < leitor->fim;
+}
+
+static inline int ler_linha_fluxo(LeitorTrace* leitor, unsigned int* endereco, char* tipo_acesso) {
+    for (;;) {
+        if (leitor->atual < leitor->fim) {
+            const char* antes = leitor->atual;
+            if (ler_linha_mmap(leitor, endereco, tipo_acesso)) return 1;
+
+            // Só espaços até o fim das linhas completas: continua no próximo trecho
+            while (antes < leitor->fim && eh_espaco(*antes)) antes++;
+            if (antes < leitor->fim) {
+                // Linha mal formada encerra a leitura, como no modo mmap
+                leitor->fim_fluxo = 1;
+                leitor->fim = leitor->fim_dados;
+                leitor->atual = leitor->fim_dados;
+                return 0;
+            }
+        }
+        if (!recarregar_texto(leitor)) return 0;
+    }
+}
+
+
+// --- TRACE BINÁRIO ---
+
+static int assinatura_binaria(const unsigned char* cabecalho) {
+    return memcmp(cabecalho, TRACE_BIN_ASSINATURA, 4) == 0 && cabecalho[4] == TRACE_BIN_VERSAO;
+}
+
+// Posiciona o leitor no próximo bloco. Retorna 0 no fim do arquivo ou se o bloco estiver corrompido
+static int carregar_bloco(LeitorTrace* leitor) {
+    uint32_t acessos, tamanho;
+
+    if (leitor->modo == LEITOR_MMAP) {
+        if (leitor->fim - leitor->atual < TRACE_BIN_TAM_CABECALHO_BLOCO) return 0;
+        acessos = trace_bin_ler_u32((const unsigned char*)leitor->atual);
+        tamanho = trace_bin_ler_u32((const unsigned char*)leitor->atual + 4);
+        leitor->atual += TRACE_BIN_TAM_CABECALHO_BLOCO;
+        if ((size_t)(leitor->fim - leitor->atual) < tamanho) {
+            fprintf(stderr, "Aviso: trace binário truncado\n");
+            leitor->atual = leitor->fim;
+            return 0;
+        }
+        leitor->bloco_atual = (const unsigned char*)leitor->atual;
+        leitor->atual += tamanho;
+    } else {
+        // O bloco é decodificado no próprio buffer do fluxo
+        if (!garantir_fluxo(leitor, TRACE_BIN_TAM_CABECALHO_BLOCO)) return 0;
+        acessos = trace_bin_ler_u32((const unsigned char*)leitor->atual);
+        tamanho = trace_bin_ler_u32((const unsigned char*)leitor->atual + 4);
+        if (!garantir_fluxo(leitor, TRACE_BIN_TAM_CABECALHO_BLOCO + (size_t)tamanho)) {
+            fprintf(stderr, "Aviso: trace binário truncado\n");
+            leitor->atual = leitor->fim_dados;
+            return 0;
+        }
+        leitor->bloco_atual = (const unsigned char*)leitor->atual + TRACE_BIN_TAM_CABECALHO_BLOCO;
+        leitor->atual += TRACE_BIN_TAM_CABECALHO_BLOCO + tamanho;
+    }
+
+    leitor->bloco_fim = leitor->bloco_atual + tamanho;
+    leitor->restantes_bloco = acessos;
+    leitor->endereco_anterior = 0;
+    return 1;
+}
+
+static inline int ler_acesso_binario(LeitorTrace* leitor, unsigned int* endereco, char* tipo_acesso) {
+    while (leitor->restantes_bloco == 0) {
+        if (!carregar_bloco(leitor)) return 0;
+    }
+
+    uint32_t valor = leitor->endereco_anterior;
+    int escrita;
+    const unsigned char* p = trace_bin_decodificar(leitor->bloco_atual, leitor->bloco_fim, &valor, &escrita);
+    if (!p) {
+        fprintf(stderr, "Aviso: trace binário corrompido\n");
+        leitor->restantes_bloco = 0;
+        if (leitor->modo == LEITOR_MMAP) {
+            leitor->atual = leitor->fim;
+        } else {
+            leitor->fim_fluxo = 1;
+            leitor->atual = leitor->fim_dados;
+        }
+        return 0;
+    }
+    leitor->bloco_atual = p;
+    leitor->restantes_bloco--;
+    leitor->endereco_anterior = valor;
+    *endereco = valor;
+    *tipo_acesso = escrita ? 'W' : 'R';
+    return 1;
+}
+
+
+// --- INTERFACE PÚBLICA ---
+
+LeitorTrace* leitor_trace_abrir(const char* nome_arquivo) {
+    LeitorTrace* leitor = calloc(1, sizeof(LeitorTrace));
+    if (!leitor) return NULL;
+
+    int entrada_padrao = strcmp(nome_arquivo, "-") == 0;
+    int fd = entrada_padrao ? STDIN_FILENO : open(nome_arquivo, O_RDONLY);
+    if (fd < 0) {
+        free(leitor);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && !entrada_padrao) {
+        leitor->tamanho = (size_t)st.st_size;
+        if (leitor->tamanho == 0) {
+            // Arquivo vazio: não há o que mapear
+            close(fd);
+            leitor->modo = LEITOR_MMAP;
+            return leitor;
+        }
+        void* mapa = mmap(NULL, leitor->tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapa != MAP_FAILED) {
+            close(fd);
+            posix_madvise(mapa, leitor->tamanho, POSIX_MADV_SEQUENTIAL);
+            leitor->modo = LEITOR_MMAP;
+            leitor->inicio = (const char*)mapa;
+            leitor->atual = leitor->inicio;
+            leitor->fim = leitor->inicio + leitor->tamanho;
+            if (leitor->tamanho >= TRACE_BIN_TAM_CABECALHO &&
+                assinatura_binaria((const unsigned char*)leitor->inicio)) {
+                leitor->binario = 1;
+                leitor->atual += TRACE_BIN_TAM_CABECALHO;
+            }
+            return leitor;
+        }
+    }
+
+    // Entrada padrão, pipes, FIFOs e arquivos que não podem ser mapeados
+    leitor->modo = LEITOR_FLUXO;
+    leitor->tamanho = 0;
+    leitor->fd = fd;
+    leitor->capacidade_buffer = TAM_BUFFER_FLUXO;
+    leitor->buffer = malloc(leitor->capacidade_buffer);
+    if (!leitor->buffer) {
+        if (!entrada_padrao) close(fd);
+        free(leitor);
+        return NULL;
+    }
+    leitor->fim_dados = leitor->buffer;
+    encher_fluxo(leitor, leitor->buffer);
+
+    // Um log texto nunca começa com o primeiro byte da assinatura binária
+    if (leitor->fim_dados > leitor->atual && *leitor->atual == TRACE_BIN_ASSINATURA[0]) {
+        if (!garantir_fluxo(leitor, TRACE_BIN_TAM_CABECALHO) ||
+            !assinatura_binaria((const unsigned char*)leitor->atual)) {
+            fprintf(stderr, "Aviso: cabeçalho de trace binário inválido\n");
+            leitor->fim_fluxo = 1;
+            leitor->atual = leitor->fim_dados;
+        } else {
+            leitor->atual += TRACE_BIN_TAM_CABECALHO;
+        }
+        leitor->binario = 1;
+    }
+    return leitor;
+}
+
+int leitor_trace_proximo(LeitorTrace* leitor, unsigned int* endereco, char* tipo_acesso) {
+    if (leitor->binario) {
+        return ler_acesso_binario(leitor, endereco, tipo_acesso);
+    }
+    if (leitor->modo == LEITOR_MMAP) {
+        return ler_linha_mmap(leitor, endereco, tipo_acesso);
+    }
+    return ler_linha_fluxo(leitor, endereco, tipo_acesso);
+}
+
+size_t leitor_trace_lote(LeitorTrace* leitor, unsigned int* enderecos, char* tipos, size_t max) {
+    size_t n = 0;
+    if (leitor->binario) {
+        while (n < max && ler_acesso_binario(leitor, &enderecos[n], &tipos[n])) n++;
+    } else if (leitor->modo == LEITOR_MMAP) {
+        while (n < max && ler_linha_mmap(leitor, &enderecos[n], &tipos[n])) n++;
+    } else {
+        while (n < max && ler_linha_fluxo(leitor, &enderecos[n], &tipos[n])) n++;
+    }
+    return n;
+}
+
+size_t leitor_trace_bytes_lidos(LeitorTrace* leitor) {
+    if (leitor->modo == LEITOR_MMAP) {
+        return (size_t)(leitor->atual - leitor->inicio);
+    }
+    return leitor->bytes_descartados + (size_t)(leitor->atual - leitor->buffer);
+}
+
+const char* leitor_trace_nome_modo(LeitorTrace* leitor) {
+    if (leitor->binario) {
+        return leitor->modo == LEITOR_MMAP ? "mmap (binário)" : "fluxo (read, binário)";
+    }
+    return leitor->modo == LEITOR_MMAP ? "mmap" : "fluxo (read)";
+}
+
+void leitor_trace_fechar(LeitorTrace* leitor) {
+    if (leitor->modo == LEITOR_MMAP) {
+        if (leitor->inicio) munmap((void*)leitor->inicio, leitor->tamanho);
+    } else {
+        if (leitor->fd != STDIN_FILENO) close(leitor->fd);
+        free(leitor->buffer);
+    }
+    free(leitor);
+}
+
+static size_t decodificar_trecho_texto(const char* inicio, const char* fim, int deslocamento_s,
+                                       uint32_t* acessos, int* completo) {
+    LeitorTrace trecho;
+    memset(&trecho, 0, sizeof(trecho));
+    trecho.modo = LEITOR_MMAP;
+    trecho.inicio = inicio;
+    trecho.atual = inicio;
+    trecho.fim = fim;
+
+    size_t n = 0;
+    unsigned int endereco;
+    char tipo;
+    for (;;) {
+        const char* antes = trecho.atual;
+        if (!ler_linha_mmap(&trecho, &endereco, &tipo)) {
+            // Só espaços até o fim do trecho indica o fim normal
+            while (antes < fim && eh_espaco(*antes)) antes++;
+            *completo = (antes == fim);
+            return n;
+        }
+        acessos[n++] = ACESSO_EMPACOTAR(endereco >> deslocamento_s, tipo);
+    }
+}
+
+static size_t decodificar_trecho_binario(const char* inicio, const char* fim, int deslocamento_s,
+                                         uint32_t* acessos, int* completo) {
+    const unsigned char* p = (const unsigned char*)inicio;
+    const unsigned char* limite = (const unsigned char*)fim;
+    size_t n = 0;
+
+    *completo = 0;
+    while (limite - p >= TRACE_BIN_TAM_CABECALHO_BLOCO) {
+        uint32_t num_acessos = trace_bin_ler_u32(p);
+        uint32_t tamanho = trace_bin_ler_u32(p + 4);
+        p += TRACE_BIN_TAM_CABECALHO_BLOCO;
+        if ((size_t)(limite - p) < tamanho) {
+            fprintf(stderr, "Aviso: trace binário truncado\n");
+            return n;
+        }
+
+        const unsigned char* fim_bloco = p + tamanho;
+        uint32_t valor = 0;
+        int escrita;
+        for (uint32_t i = 0; i < num_acessos; i++) {
+            p = trace_bin_decodificar(p, fim_bloco, &valor, &escrita);
+            if (!p) {
+                fprintf(stderr, "Aviso: trace binário corrompido\n");
+                return n;
+            }
+            acessos[n++] = ((valor >> deslocamento_s) << 1) | (uint32_t)escrita;
+        }
+        p = fim_bloco;
+    }
+    // Sobras menores que um cabeçalho são ignoradas, como no leitor sequencial
+    *completo = 1;
+    return n;
+}
+
+size_t leitor_trace_decodificar_trecho(const char* inicio, const char* fim, int binario,
+                                       int deslocamento_s, uint32_t* acessos, int* completo) {
+    if (binario) return decodificar_trecho_binario(inicio, fim, deslocamento_s, acessos, completo);
+    return decodificar_trecho_texto(inicio, fim, deslocamento_s, acessos, completo);
+}
+
+TraceCarregado* trace_carregar(const char* nome_arquivo) {
+    LeitorTrace* leitor = leitor_trace_abrir(nome_arquivo);
+    if (!leitor) return NULL;
+
+    // Para logs texto no formato fixo, cada linha tem 11 bytes
+    size_t capacidade = leitor->tamanho > 0 ? leitor->tamanho / 11 + 1 : 1 << 16;
+    TraceCarregado* trace = malloc(sizeof(TraceCarregado));
+    trace->enderecos = malloc(capacidade * sizeof(unsigned int));
+    trace->tipos = malloc(capacidade);
+    trace->num_acessos = 0;
+
+    size_t lidos;
+    do {
+        if (trace->num_acessos == capacidade) {
+            capacidade *= 2;
+            trace->enderecos = realloc(trace->enderecos, capacidade * sizeof(unsigned int));
+            trace->tipos = realloc(trace->tipos, capacidade);
+        }
+        lidos = leitor_trace_lote(leitor, trace->enderecos + trace->num_acessos,
+                                  trace->tipos + trace->num_acessos, capacidade - trace->num_acessos);
+        trace->num_acessos += lidos;
+    } while (lidos > 0);
+
+    leitor_trace_fechar(leitor);
+    return trace;
+}
+
+void trace_liberar(TraceCarregado* trace) {
+    if (trace == NULL) return;
+    free(trace->enderecos);
+    free(trace->tipos);
+    free(trace);
+}
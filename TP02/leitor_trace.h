@@ -0,0 +1,93 @@
+#ifndef LEITOR_TRACE_H
+#define LEITOR_TRACE_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Leitor de arquivos de log (trace) no formato "%08x R|W" ou no formato
+// binário compacto descrito em trace_binario.h (detectado pela assinatura).
+// Arquivos regulares são mapeados em memória com mmap e interpretados por um
+// decodificador hexadecimal próprio. A entrada padrão ("-"), pipes e FIFOs
+// são lidos com read(2) em um buffer grande e interpretados no próprio buffer
+// pelo mesmo decodificador; só a linha (ou bloco binário) incompleta no fim
+// de cada leitura é copiada para o início do buffer antes da próxima
+
+typedef enum {
+    LEITOR_MMAP,
+    LEITOR_FLUXO
+} ModoLeitor;
+
+typedef struct {
+    ModoLeitor modo;
+
+    // Região sendo interpretada e posição atual de leitura. No modo fluxo,
+    // [inicio, fim) são as linhas completas presentes no buffer
+    const char* inicio;
+    const char* atual;
+    const char* fim;
+    size_t tamanho;
+
+    // Modo fluxo: descritor, buffer e dados válidos em [buffer, fim_dados)
+    int fd;
+    char* buffer;
+    size_t capacidade_buffer;
+    const char* fim_dados;
+    size_t bytes_descartados; // bytes já consumidos e removidos do buffer
+    int fim_fluxo;            // read(2) chegou ao fim (ou falhou)
+
+    // Trace binário: bloco sendo decodificado
+    int binario;
+    const unsigned char* bloco_atual;
+    const unsigned char* bloco_fim;
+    unsigned int restantes_bloco;
+    unsigned int endereco_anterior;
+} LeitorTrace;
+
+// Abre o trace ("-" é a entrada padrão). Retorna NULL (com errno definido) se o arquivo não puder ser aberto
+LeitorTrace* leitor_trace_abrir(const char* nome_arquivo);
+
+// Lê o próximo acesso. Retorna 1 em caso de sucesso e 0 no fim do arquivo
+// (ou na primeira linha mal formada, como o fscanf faria)
+int leitor_trace_proximo(LeitorTrace* leitor, unsigned int* endereco, char* tipo_acesso);
+
+// Lê até 'max' acessos de uma vez. Retorna quantos foram lidos (0 no fim)
+size_t leitor_trace_lote(LeitorTrace* leitor, unsigned int* enderecos, char* tipos, size_t max);
+
+// Quantidade de bytes do arquivo já consumidos
+size_t leitor_trace_bytes_lidos(LeitorTrace* leitor);
+
+// Nome do modo de leitura, para o relatório
+const char* leitor_trace_nome_modo(LeitorTrace* leitor);
+
+void leitor_trace_fechar(LeitorTrace* leitor);
+
+// Acesso empacotado: (número da página << 1) | 1 se for escrita
+#define ACESSO_EMPACOTAR(pagina, tipo) (((uint32_t)(pagina) << 1) | ((tipo) == 'W'))
+#define ACESSO_PAGINA(acesso) ((acesso) >> 1)
+#define ACESSO_TIPO(acesso) (((acesso) & 1) ? 'W' : 'R')
+
+// Decodifica o trecho [inicio, fim) de um trace mapeado em memória para acessos
+// empacotados, com os endereços já deslocados de 'deslocamento_s' bits. Em logs
+// texto o trecho deve começar no início de uma linha (cada acesso ocupa uma
+// linha); em traces binários, no cabeçalho de um bloco. 'acessos' deve ter
+// espaço para (fim - inicio) / 2 + 1 acessos no texto, ou para a soma dos
+// acessos dos blocos no binário. Retorna quantos acessos foram decodificados e
+// zera *completo se uma linha mal formada ou um bloco corrompido interrompeu o trecho
+size_t leitor_trace_decodificar_trecho(const char* inicio, const char* fim, int binario,
+                                       int deslocamento_s, uint32_t* acessos, int* completo);
+
+// Trace completo decodificado em memória, para ser compartilhado (somente
+// leitura) por várias simulações
+typedef struct {
+    unsigned int* enderecos;
+    char* tipos;
+    size_t num_acessos;
+} TraceCarregado;
+
+// Lê o trace inteiro. Retorna NULL (com errno definido) se o arquivo não puder ser aberto
+TraceCarregado* trace_carregar(const char* nome_arquivo);
+
+void trace_liberar(TraceCarregado* trace);
+
+#endif
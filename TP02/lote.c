@@ -0,0 +1,173 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lote.h"
+#include "configuracao.h"
+#include "leitor_trace.h"
+#include "pool_tarefas.h"
+
+#define MAX_LINHA 1024
+
+typedef struct {
+    char* nome_trace;
+    int indice_trace;
+    Configuracao config;
+    unsigned long long semente;
+    int falhou;
+
+    // Relatório gerado pela tarefa
+    char* saida;
+    size_t tamanho_saida;
+} TarefaLote;
+
+typedef struct {
+    TarefaLote* tarefas;
+    TraceCarregado** traces;
+} ContextoLote;
+
+static void executar_tarefa(void* contexto, int indice) {
+    ContextoLote* ctx = (ContextoLote*)contexto;
+    TarefaLote* tarefa = &ctx->tarefas[indice];
+    FILE* out = open_memstream(&tarefa->saida, &tarefa->tamanho_saida);
+
+    fprintf(out, "\n>>> Teste: Log=%s, Alg=%s, Mem=%dKB, Pag=%dKB, Tabela=%s",
+            tarefa->nome_trace, tarefa->config.algoritmo, tarefa->config.tam_memoria_kb,
+            tarefa->config.tam_pagina_kb, tarefa->config.tabela);
+
+    TraceCarregado* trace = ctx->traces[tarefa->indice_trace];
+    if (trace == NULL) {
+        fprintf(out, "\nErro: não foi possível ler o arquivo de log.\n");
+        tarefa->falhou = 1;
+    } else {
+        tarefa->config.trace = trace;
+        if (!criar_configuracao(&tarefa->config, tarefa->semente)) {
+            fprintf(out, "\nErro: configuração inválida (ver mensagens acima).\n");
+            tarefa->falhou = 1;
+        } else {
+            configuracao_simular_trace(&tarefa->config);
+            imprimir_relatorio(out, tarefa->nome_trace, &tarefa->config);
+            configuracao_destruir(&tarefa->config);
+        }
+    }
+    fprintf(out, "-----------------------\n");
+    fclose(out);
+}
+
+// Lê o arquivo de tarefas: uma por linha, no formato
+//   <arquivo.log> <alg_subst> <tam_pag_kb> <tam_mem_kb> [tabela]
+// Linhas vazias e iniciadas por '#' são ignoradas
+static TarefaLote* ler_tarefas(const char* nome_arquivo, const char* tabela_padrao, const char* origem_padrao,
+                               int* num_tarefas) {
+    FILE* arquivo = fopen(nome_arquivo, "r");
+    if (!arquivo) {
+        perror("Erro ao abrir o arquivo de tarefas");
+        return NULL;
+    }
+
+    int capacidade = 16;
+    TarefaLote* tarefas = malloc(capacidade * sizeof(TarefaLote));
+    char linha[MAX_LINHA];
+    int n = 0, num_linha = 0;
+    while (fgets(linha, sizeof(linha), arquivo)) {
+        num_linha++;
+        char trace[MAX_LINHA], algoritmo[MAX_LINHA], tabela[MAX_LINHA];
+        int pagina, memoria;
+        char* p = linha;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '#' || *p == '\n' || *p == '\0') continue;
+
+        int campos = sscanf(p, "%s %s %d %d %s", trace, algoritmo, &pagina, &memoria, tabela);
+        if (campos < 4) {
+            fprintf(stderr, "Aviso: linha %d do arquivo de tarefas ignorada (formato inválido).\n", num_linha);
+            continue;
+        }
+        if (n == capacidade) {
+            capacidade *= 2;
+            tarefas = realloc(tarefas, capacidade * sizeof(TarefaLote));
+        }
+        TarefaLote* t = &tarefas[n++];
+        memset(t, 0, sizeof(TarefaLote));
+        t->nome_trace = strdup(trace);
+        t->config.algoritmo = strdup(algoritmo);
+        t->config.tabela = strdup(campos == 5 ? tabela : tabela_padrao);
+        t->config.origem_tabela = campos == 5 ? "arquivo de tarefas" : origem_padrao;
+        t->config.tam_pagina_kb = pagina;
+        t->config.tam_memoria_kb = memoria;
+    }
+    fclose(arquivo);
+    *num_tarefas = n;
+    return tarefas;
+}
+
+int executar_lote(int argc, char *argv[]) {
+    if (argc < 3 || argc > 4) {
+        fprintf(stderr, "Uso: %s lote <arquivo_tarefas> [num_threads]\n", argv[0]);
+        fprintf(stderr, "  Cada linha: <arquivo.log> <alg_subst> <tam_pag_kb> <tam_mem_kb> [tabela]\n");
+        fprintf(stderr, "  Sem [num_threads], usa SIM_THREADS ou o número de processadores.\n");
+        return 1;
+    }
+
+    const char* tabela_padrao = getenv("PAGE_TABLE_TYPE");
+    const char* origem_padrao = tabela_padrao ? "PAGE_TABLE_TYPE" : NULL;
+    if (tabela_padrao == NULL) tabela_padrao = "hierarquica2";
+    int num_threads = argc == 4 ? atoi(argv[3]) : pool_threads_padrao();
+
+    int num_tarefas = 0;
+    TarefaLote* tarefas = ler_tarefas(argv[2], tabela_padrao, origem_padrao, &num_tarefas);
+    if (tarefas == NULL) return 1;
+
+    // Cada trace distinto é lido uma única vez e compartilhado entre as tarefas
+    printf("Executando o simulador...\n");
+    double inicio_leitura = tempo_em_segundos();
+    TraceCarregado** traces = malloc((num_tarefas > 0 ? num_tarefas : 1) * sizeof(TraceCarregado*));
+    const char** nomes_traces = malloc((num_tarefas > 0 ? num_tarefas : 1) * sizeof(char*));
+    int num_traces = 0;
+    for (int i = 0; i < num_tarefas; i++) {
+        int t = 0;
+        while (t < num_traces && strcmp(nomes_traces[t], tarefas[i].nome_trace) != 0) t++;
+        if (t == num_traces) {
+            nomes_traces[t] = tarefas[i].nome_trace;
+            traces[t] = trace_carregar(tarefas[i].nome_trace);
+            if (traces[t] == NULL) {
+                fprintf(stderr, "Erro ao abrir o arquivo de log '%s': ", tarefas[i].nome_trace);
+                perror(NULL);
+            }
+            num_traces++;
+        }
+        tarefas[i].indice_trace = t;
+        tarefas[i].semente = (unsigned long long)time(NULL) + (unsigned long long)i;
+    }
+    double tempo_leitura = tempo_em_segundos() - inicio_leitura;
+
+    ContextoLote ctx;
+    ctx.tarefas = tarefas;
+    ctx.traces = traces;
+    EstatisticasPool estatisticas;
+    pool_executar(num_threads, num_tarefas, executar_tarefa, &ctx, &estatisticas);
+
+    // Relatórios na ordem do arquivo de tarefas
+    int falhas = 0;
+    for (int i = 0; i < num_tarefas; i++) {
+        fwrite(tarefas[i].saida, 1, tarefas[i].tamanho_saida, stdout);
+        falhas += tarefas[i].falhou;
+    }
+    printf("\nLote: %d tarefas, %d traces lidos em %.3f s, simulação em %.3f s com %d threads (%lu tarefas roubadas).\n",
+           num_tarefas, num_traces, tempo_leitura, estatisticas.tempo_total,
+           estatisticas.num_threads, estatisticas.roubos);
+    if (falhas > 0) fprintf(stderr, "Erro: %d de %d tarefas falharam.\n", falhas, num_tarefas);
+
+    for (int t = 0; t < num_traces; t++) trace_liberar(traces[t]);
+    for (int i = 0; i < num_tarefas; i++) {
+        free(tarefas[i].nome_trace);
+        free((char*)tarefas[i].config.algoritmo);
+        free((char*)tarefas[i].config.tabela);
+        free(tarefas[i].saida);
+    }
+    free(traces);
+    free(nomes_traces);
+    free(tarefas);
+    return falhas > 0;
+}
@@ -0,0 +1,10 @@
+#ifndef LOTE_H
+#define LOTE_H
+
+// Modo lote: executa uma lista de simulações (trace, algoritmo, página, memória,
+// tabela) em paralelo, com os traces lidos uma única vez e compartilhados entre
+// as tarefas. Os relatórios são impressos na ordem da lista, qualquer que seja a
+// ordem em que as tarefas terminarem
+int executar_lote(int argc, char *argv[]);
+
+#endif
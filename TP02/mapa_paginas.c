@@ -0,0 +1,108 @@
+#include <stdlib.h>
+#include "mapa_paginas.h"
+
+// Hash inteiro (finalizador do MurmurHash3)
+static inline size_t hash_pagina(uint32_t chave, size_t mascara) {
+    uint32_t h = chave;
+    h ^= h >> 16;
+    h *= 0x85EBCA6BU;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35U;
+    h ^= h >> 16;
+    return h & mascara;
+}
+
+static void alocar(MapaPaginas* mapa, size_t capacidade) {
+    mapa->capacidade = capacidade;
+    mapa->tamanho = 0;
+    mapa->chaves = malloc(capacidade * sizeof(uint32_t));
+    mapa->valores = malloc(capacidade * sizeof(int));
+    mapa->ocupado = calloc(capacidade, sizeof(uint8_t));
+}
+
+MapaPaginas* mapa_paginas_criar(size_t capacidade_inicial) {
+    MapaPaginas* mapa = malloc(sizeof(MapaPaginas));
+    size_t capacidade = 16;
+    while (capacidade < capacidade_inicial * 2) capacidade *= 2;
+    alocar(mapa, capacidade);
+    return mapa;
+}
+
+int mapa_paginas_buscar(const MapaPaginas* mapa, uint32_t chave, int* valor) {
+    size_t mascara = mapa->capacidade - 1;
+    for (size_t i = hash_pagina(chave, mascara); mapa->ocupado[i]; i = (i + 1) & mascara) {
+        if (mapa->chaves[i] == chave) {
+            *valor = mapa->valores[i];
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Dobra a capacidade quando a ocupação passa de 1/2
+static void crescer(MapaPaginas* mapa) {
+    uint32_t* chaves = mapa->chaves;
+    int* valores = mapa->valores;
+    uint8_t* ocupado = mapa->ocupado;
+    size_t capacidade = mapa->capacidade;
+
+    alocar(mapa, capacidade * 2);
+    for (size_t i = 0; i < capacidade; i++) {
+        if (ocupado[i]) mapa_paginas_inserir(mapa, chaves[i], valores[i]);
+    }
+    free(chaves);
+    free(valores);
+    free(ocupado);
+}
+
+void mapa_paginas_inserir(MapaPaginas* mapa, uint32_t chave, int valor) {
+    size_t mascara = mapa->capacidade - 1;
+    size_t i = hash_pagina(chave, mascara);
+    while (mapa->ocupado[i]) {
+        if (mapa->chaves[i] == chave) {
+            mapa->valores[i] = valor;
+            return;
+        }
+        i = (i + 1) & mascara;
+    }
+
+    if ((mapa->tamanho + 1) * 2 > mapa->capacidade) {
+        crescer(mapa);
+        mapa_paginas_inserir(mapa, chave, valor);
+        return;
+    }
+    mapa->ocupado[i] = 1;
+    mapa->chaves[i] = chave;
+    mapa->valores[i] = valor;
+    mapa->tamanho++;
+}
+
+int mapa_paginas_remover(MapaPaginas* mapa, uint32_t chave) {
+    size_t mascara = mapa->capacidade - 1;
+    size_t i = hash_pagina(chave, mascara);
+    while (mapa->ocupado[i] && mapa->chaves[i] != chave) i = (i + 1) & mascara;
+    if (!mapa->ocupado[i]) return 0;
+
+    // Desloca para trás as entradas do mesmo agrupamento que ficariam inalcançáveis
+    size_t livre = i;
+    for (size_t j = (i + 1) & mascara; mapa->ocupado[j]; j = (j + 1) & mascara) {
+        size_t ideal = hash_pagina(mapa->chaves[j], mascara);
+        // A entrada em j pode ocupar 'livre' se 'ideal' não estiver entre livre (exclusive) e j
+        if (((j - ideal) & mascara) >= ((j - livre) & mascara)) {
+            mapa->chaves[livre] = mapa->chaves[j];
+            mapa->valores[livre] = mapa->valores[j];
+            livre = j;
+        }
+    }
+    mapa->ocupado[livre] = 0;
+    mapa->tamanho--;
+    return 1;
+}
+
+void mapa_paginas_destruir(MapaPaginas* mapa) {
+    if (mapa == NULL) return;
+    free(mapa->chaves);
+    free(mapa->valores);
+    free(mapa->ocupado);
+    free(mapa);
+}
@@ -0,0 +1,33 @@
+#ifndef MAPA_PAGINAS_H
+#define MAPA_PAGINAS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Mapa hash de número de página (uint32) para um inteiro, com endereçamento
+// aberto e sondagem linear. Remoções deslocam as entradas seguintes para trás,
+// então não há marcas de remoção e as consultas continuam curtas mesmo com
+// inserções e remoções constantes
+
+typedef struct {
+    uint32_t* chaves;
+    int* valores;
+    uint8_t* ocupado;
+    size_t capacidade; // potência de 2
+    size_t tamanho;
+} MapaPaginas;
+
+MapaPaginas* mapa_paginas_criar(size_t capacidade_inicial);
+
+// Retorna 1 e preenche *valor se a chave existir; 0 caso contrário
+int mapa_paginas_buscar(const MapaPaginas* mapa, uint32_t chave, int* valor);
+
+// Insere ou atualiza o valor associado à chave
+void mapa_paginas_inserir(MapaPaginas* mapa, uint32_t chave, int valor);
+
+// Remove a chave. Retorna 1 se ela existia
+int mapa_paginas_remover(MapaPaginas* mapa, uint32_t chave);
+
+void mapa_paginas_destruir(MapaPaginas* mapa);
+
+#endif
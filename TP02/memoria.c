@@ -3,66 +3,89 @@
 #include "memoria.h"
 #include "algoritmos.h"
 
-static Frame* memoria_fisica = NULL;
-static long contador_tempo = 0;
-
-unsigned int paginas_lidas = 0;
-unsigned int paginas_escritas = 0;
-int debug_mode = 0;
-unsigned long total_lookup_cost = 0;
+// Gravação antecipada de uma página suja, pedida pela política
+static void gravar_quadro(void* contexto, int quadro) {
+    Simulacao* sim = (Simulacao*)contexto;
+    if (!sim->memoria_fisica[quadro].suja) return;
+    sim->paginas_escritas++;
+    sim->memoria_fisica[quadro].suja = 0;
+}
 
+Simulacao* simulacao_criar(int num_quadros, PageTable* pt, Politica* politica) {
+    Simulacao* sim = (Simulacao*) calloc(1, sizeof(Simulacao));
+    sim->num_quadros = num_quadros;
+    sim->pt = pt;
+    sim->politica = politica;
+    politica->gravar_quadro = gravar_quadro;
+    politica->contexto_gravacao = sim;
+    sim->memoria_fisica = (Frame*) malloc(num_quadros * sizeof(Frame));
 
-void inicializar_memoria(int num_quadros) {
-    memoria_fisica = (Frame*) malloc(num_quadros * sizeof(Frame));
+    // Pilha de quadros livres. Os quadros são empilhados em ordem decrescente para
+    // que sejam ocupados na mesma ordem (0, 1, 2...) da antiga varredura linear
+    sim->quadros_livres = (int*) malloc(num_quadros * sizeof(int));
     for (int i = 0; i < num_quadros; i++) {
-        memoria_fisica[i].ocupado = 0;
+        sim->memoria_fisica[i].ocupado = 0;
+        sim->quadros_livres[i] = num_quadros - 1 - i;
     }
+    sim->num_quadros_livres = num_quadros;
+#ifdef INSTRUMENTACAO
+    sim->instr = instrumentacao_criar();
+    pt->sondagens = &sim->instr->sondagens;
+#endif
+    return sim;
 }
 
-void liberar_memoria() {
-    if (memoria_fisica != NULL) free(memoria_fisica);
+void simulacao_destruir(Simulacao* sim) {
+    if (sim == NULL) return;
+    if (sim->pt) sim->pt->destroy(sim->pt);
+    if (sim->politica) sim->politica->destroy(sim->politica);
+    paginas_grandes_destruir(sim->grandes);
+#ifdef INSTRUMENTACAO
+    instrumentacao_destruir(sim->instr);
+#endif
+    free(sim->memoria_fisica);
+    free(sim->quadros_livres);
+    free(sim);
 }
 
-void acessar_endereco(unsigned int numero_pagina, char tipo_acesso,
-                      PageTable* pt, int num_quadros,
-                      int (*algoritmo_substituicao)(Frame*, int)) {
-    contador_tempo++;
-    int cost = 0;
-    int indice_quadro = pt->lookup(pt, numero_pagina, &cost);
-    total_lookup_cost += cost;
+void simulacao_usar_paginas_grandes(Simulacao* sim, PaginasGrandes* grandes) {
+    sim->grandes = grandes;
+}
 
-    // Page Hit
-    if (indice_quadro != -1) {
-        if (debug_mode) printf("Hit na página %u (quadro %d)\n", numero_pagina, indice_quadro);
-        memoria_fisica[indice_quadro].ultimo_acesso = contador_tempo;
-        memoria_fisica[indice_quadro].frequencia++;
-        if (tipo_acesso == 'W') {
-            memoria_fisica[indice_quadro].suja = 1;
-        }
-        return;
+static void registrar_hit(Simulacao* sim, int indice_quadro, char tipo_acesso) {
+    Frame* memoria_fisica = sim->memoria_fisica;
+    Politica* politica = sim->politica;
+    memoria_fisica[indice_quadro].ultimo_acesso = sim->contador_tempo;
+    memoria_fisica[indice_quadro].frequencia++;
+    if (tipo_acesso == 'W') {
+        memoria_fisica[indice_quadro].suja = 1;
     }
+    if (politica->registrar_acesso) politica->registrar_acesso(politica, indice_quadro);
+    if (tipo_acesso == 'W' && politica->registrar_escrita) politica->registrar_escrita(politica, indice_quadro);
+}
 
-    // Page Fault
-    if (debug_mode) printf("Page fault para a página %u\n", numero_pagina);
-    paginas_lidas++;
+// Carrega a página num quadro livre ou no escolhido pela política. Com páginas
+// grandes, retorna 1 se a região da página deve ser promovida
+static int carregar_pagina(Simulacao* sim, unsigned int numero_pagina, char tipo_acesso) {
+    Frame* memoria_fisica = sim->memoria_fisica;
+    PageTable* pt = sim->pt;
+    Politica* politica = sim->politica;
 
-    int quadro_alvo = -1;
-    for (int i = 0; i < num_quadros; i++) {
-        if (!memoria_fisica[i].ocupado) {
-            quadro_alvo = i;
-            break;
-        }
-    }
+    if (politica->registrar_falta) politica->registrar_falta(politica, numero_pagina);
 
-    if (quadro_alvo == -1) {
-        quadro_alvo = algoritmo_substituicao(memoria_fisica, num_quadros);
-        if (debug_mode) printf("Substituindo quadro %d (página %u)\n", quadro_alvo, memoria_fisica[quadro_alvo].numero_pagina_virtual);
+    int quadro_alvo;
+    if (sim->num_quadros_livres > 0) {
+        quadro_alvo = sim->quadros_livres[--sim->num_quadros_livres];
+    } else {
+        quadro_alvo = politica->escolher_vitima(politica, memoria_fisica, sim->num_quadros);
+        if (sim->debug) printf("Substituindo quadro %d (página %u)\n", quadro_alvo, memoria_fisica[quadro_alvo].numero_pagina_virtual);
 
         // Invalida o mapeamento antigo na tabela de páginas
         pt->update(pt, memoria_fisica[quadro_alvo].numero_pagina_virtual, -1);
+        if (sim->grandes) paginas_grandes_removida(sim->grandes, memoria_fisica[quadro_alvo].numero_pagina_virtual);
         
         if (memoria_fisica[quadro_alvo].suja) {
-            paginas_escritas++;
+            sim->paginas_escritas++;
         }
     }
 
@@ -70,9 +93,85 @@ void acessar_endereco(unsigned int numero_pagina, char tipo_acesso,
     memoria_fisica[quadro_alvo].ocupado = 1;
     memoria_fisica[quadro_alvo].numero_pagina_virtual = numero_pagina;
     memoria_fisica[quadro_alvo].suja = (tipo_acesso == 'W');
-    memoria_fisica[quadro_alvo].ultimo_acesso = contador_tempo;
+    memoria_fisica[quadro_alvo].ultimo_acesso = sim->contador_tempo;
     memoria_fisica[quadro_alvo].frequencia = 1;
+    if (politica->registrar_carga) politica->registrar_carga(politica, quadro_alvo);
+    if (tipo_acesso == 'W' && politica->registrar_escrita) politica->registrar_escrita(politica, quadro_alvo);
 
     // Atualiza a tabela de páginas com o novo mapeamento
     pt->update(pt, numero_pagina, quadro_alvo);
+    return sim->grandes ? paginas_grandes_carregada(sim->grandes, numero_pagina, quadro_alvo) : 0;
+}
+
+// Carrega as páginas que faltam na região e a promove a página grande
+static void promover_regiao(Simulacao* sim, unsigned int regiao) {
+    PaginasGrandes* g = sim->grandes;
+    unsigned int primeira = regiao << g->deslocamento;
+    if (sim->debug) printf("Promovendo a região %u (páginas %u a %u)\n", regiao, primeira, primeira + g->paginas_por_regiao - 1);
+    for (unsigned int i = 0; i < g->paginas_por_regiao; i++) {
+        if (paginas_grandes_residente(g, primeira + i)) continue;
+        carregar_pagina(sim, primeira + i, 'R');
+        sim->paginas_lidas++;
+        g->paginas_lidas_promocao++;
+    }
+    paginas_grandes_promover(g, regiao);
+}
+
+void simulacao_acessar(Simulacao* sim, unsigned int numero_pagina, char tipo_acesso) {
+    PageTable* pt = sim->pt;
+
+    INSTR_ACESSO(sim);
+    sim->contador_tempo++;
+    sim->total_acessos++;
+    int cost = 0;
+    int indice_quadro;
+
+    // Regiões promovidas são traduzidas pela tabela grande
+    if (sim->grandes && (indice_quadro = paginas_grandes_consultar(sim->grandes, numero_pagina, &cost)) != -1) {
+        sim->total_lookup_cost += cost;
+        INSTR_CONSULTA(sim, cost);
+        if (sim->debug) printf("Hit na página %u (quadro %d, página grande)\n", numero_pagina, indice_quadro);
+        registrar_hit(sim, indice_quadro, tipo_acesso);
+        return;
+    }
+
+    indice_quadro = pt->lookup(pt, numero_pagina, &cost);
+    sim->total_lookup_cost += cost;
+    INSTR_CONSULTA(sim, cost);
+
+    // Page Hit
+    if (indice_quadro != -1) {
+        if (sim->debug) printf("Hit na página %u (quadro %d)\n", numero_pagina, indice_quadro);
+        registrar_hit(sim, indice_quadro, tipo_acesso);
+        return;
+    }
+
+    // Page Fault
+    if (sim->debug) printf("Page fault para a página %u\n", numero_pagina);
+    sim->paginas_lidas++;
+    if (carregar_pagina(sim, numero_pagina, tipo_acesso)) {
+        promover_regiao(sim, numero_pagina >> sim->grandes->deslocamento);
+    }
+}
+
+void simulacao_imprimir_resultados(Simulacao* sim, FILE* out) {
+    PageTable* pt = sim->pt;
+    fprintf(out, "Resultados da Simulação:\n");
+    fprintf(out, "  Total de acessos à memória: %lu\n", sim->total_acessos);
+    fprintf(out, "  Total de page faults (páginas lidas): %u\n", sim->paginas_lidas);
+    fprintf(out, "  Total de páginas escritas (dirty pages): %u\n\n", sim->paginas_escritas);
+    fprintf(out, "Análise da Tabela de Páginas:\n");
+    fprintf(out, "  Custo de memória da tabela: %.2f KB\n", (double)pt->memory_cost(pt) / 1024.0);
+    fprintf(out, "  Custo médio de consulta: %.2f acessos/operação\n", (double)sim->total_lookup_cost / (double)sim->total_acessos);
+    if (pt->print_stats) pt->print_stats(pt, out);
+#ifdef INSTRUMENTACAO
+    instrumentacao_fechar_janela(sim->instr, sim->total_acessos, sim->paginas_lidas, sim->paginas_escritas,
+                                 sim->total_lookup_cost);
+    instrumentacao_imprimir(sim->instr, out);
+#endif
+    if (sim->grandes) {
+        PaginasGrandes* g = sim->grandes;
+        paginas_grandes_imprimir(g, out, sim->total_acessos - g->acessos, sim->paginas_lidas - g->paginas_lidas_promocao,
+                                 sim->total_lookup_cost - g->custo_consulta);
+    }
 }
\ No newline at end of file
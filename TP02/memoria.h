@@ -3,6 +3,8 @@
 
 #include <stdio.h>
 #include "pagetable.h"
+#include "paginas_grandes.h"
+#include "instrumentacao.h"
 
 typedef struct {
     int ocupado;
@@ -12,17 +14,81 @@ typedef struct {
     long frequencia;
 } Frame;
 
-extern unsigned int paginas_lidas;
-extern unsigned int paginas_escritas;
-extern int debug_mode;
+// Estrutura genérica para uma política de substituição
+// Assim como a PageTable, usa ponteiros de função para implementar polimorfismo em C
+typedef struct Politica {
+    void* impl; // Estado específico da política (ex: lista de recência do LRU)
 
-void inicializar_memoria(int num_quadros);
+    // Notifica um page fault para a página, antes da escolha da vítima (que só
+    // ocorre se não houver quadros livres) e de registrar_carga. Pode ser NULL
+    void (*registrar_falta)(struct Politica* p, unsigned int pagina);
 
-// Agora recebe a Tabela de Páginas como argumento
-void acessar_endereco(unsigned int numero_pagina, char tipo_acesso,
-                      PageTable* pt, int num_quadros,
-                      int (*algoritmo_substituicao)(Frame*, int));
+    // Escolhe o quadro a ser substituído quando não há quadros livres
+    int (*escolher_vitima)(struct Politica* p, Frame* memoria_fisica, int num_quadros);
 
-void liberar_memoria();
+    // Notifica um acesso a uma página já presente no quadro (hit). Pode ser NULL
+    void (*registrar_acesso)(struct Politica* p, int quadro);
+
+    // Notifica que uma nova página foi carregada no quadro. Pode ser NULL
+    void (*registrar_carga)(struct Politica* p, int quadro);
+
+    // Notifica uma escrita na página do quadro (após registrar_acesso ou
+    // registrar_carga), para políticas que usam o bit sujo. Pode ser NULL
+    void (*registrar_escrita)(struct Politica* p, int quadro);
+
+    // Libera a política e seu estado
+    void (*destroy)(struct Politica* p);
+
+    // Preenchidos por simulacao_criar (NULL fora de uma simulação): grava a
+    // página suja do quadro antes da substituição, para políticas que agendam
+    // gravações (WSClock). A simulação conta a escrita e limpa o bit sujo
+    void (*gravar_quadro)(void* contexto, int quadro);
+    void* contexto_gravacao;
+} Politica;
+
+// Contexto de uma simulação: quadros, contadores, tabela de páginas e política.
+// Não há estado global, então várias simulações independentes podem existir no
+// mesmo processo (inclusive em threads diferentes, uma simulação por thread)
+typedef struct {
+    Frame* memoria_fisica;
+    int num_quadros;
+    long contador_tempo;
+
+    // Pilha de quadros livres
+    int* quadros_livres;
+    int num_quadros_livres;
+
+    PageTable* pt;
+    Politica* politica;
+    int debug;
+
+    // Segundo tamanho de página, opcional (NULL: só páginas base)
+    PaginasGrandes* grandes;
+
+    // Contadores para o relatório
+    unsigned long total_acessos;
+    unsigned int paginas_lidas;
+    unsigned int paginas_escritas;
+    unsigned long total_lookup_cost;
+
+#ifdef INSTRUMENTACAO
+    Instrumentacao* instr;
+#endif
+} Simulacao;
+
+// Cria uma simulação com memória vazia. A simulação passa a ser dona da
+// tabela de páginas e da política, que são liberadas por simulacao_destruir
+Simulacao* simulacao_criar(int num_quadros, PageTable* pt, Politica* politica);
+
+// Ativa as páginas grandes. A simulação passa a ser dona de 'grandes'
+void simulacao_usar_paginas_grandes(Simulacao* sim, PaginasGrandes* grandes);
+
+// Processa um acesso à página informada ('R' ou 'W')
+void simulacao_acessar(Simulacao* sim, unsigned int numero_pagina, char tipo_acesso);
+
+// Imprime os resultados da simulação e a análise da tabela de páginas
+void simulacao_imprimir_resultados(Simulacao* sim, FILE* out);
+
+void simulacao_destruir(Simulacao* sim);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include <stdlib.h>
+#include <string.h>
+#include "mrc.h"
+
+#define CAPACIDADE_INICIAL 4096
+
+// --- ÁRVORE DE FENWICK (índices 1..capacidade_instantes) ---
+
+static void fenwick_somar(CurvaLRU* curva, size_t instante, int valor) {
+    for (size_t i = instante + 1; i <= curva->capacidade_instantes; i += i & (~i + 1)) {
+        curva->arvore[i] += valor;
+    }
+}
+
+// Soma dos instantes 0..instante-1
+static long fenwick_prefixo(CurvaLRU* curva, size_t instante) {
+    long soma = 0;
+    for (size_t i = instante; i > 0; i -= i & (~i + 1)) {
+        soma += curva->arvore[i];
+    }
+    return soma;
+}
+
+// Renumera os últimos acessos de cada página para 0..num_paginas-1, mantendo a
+// ordem, quando os instantes se esgotam. Cada compactação libera pelo menos
+// metade dos instantes, então o custo amortizado por acesso é constante
+static void compactar_instantes(CurvaLRU* curva) {
+    size_t capacidade = curva->capacidade_instantes;
+    size_t nova_capacidade = capacidade;
+    while (nova_capacidade < curva->num_paginas * 2) nova_capacidade *= 2;
+
+    int* pagina_no_instante = malloc(nova_capacidade * sizeof(int));
+    size_t k = 0;
+    for (size_t t = 0; t < curva->instante; t++) {
+        int id = curva->pagina_no_instante[t];
+        if (id >= 0) {
+            pagina_no_instante[k] = id;
+            curva->ultimo_instante[id] = k;
+            k++;
+        }
+    }
+    for (size_t t = k; t < nova_capacidade; t++) pagina_no_instante[t] = -1;
+    free(curva->pagina_no_instante);
+    curva->pagina_no_instante = pagina_no_instante;
+
+    // Reconstrói a árvore em O(n) com os k primeiros instantes marcados
+    free(curva->arvore);
+    curva->arvore = calloc(nova_capacidade + 1, sizeof(int));
+    curva->capacidade_instantes = nova_capacidade;
+    for (size_t i = 1; i <= k; i++) curva->arvore[i] = 1;
+    for (size_t i = 1; i <= nova_capacidade; i++) {
+        size_t pai = i + (i & (~i + 1));
+        if (pai <= nova_capacidade) curva->arvore[pai] += curva->arvore[i];
+    }
+    curva->instante = k;
+}
+
+static int nova_pagina(CurvaLRU* curva, uint32_t numero_pagina) {
+    if (curva->num_paginas == curva->capacidade_paginas) {
+        size_t antiga = curva->capacidade_paginas;
+        size_t nova = antiga * 2;
+        curva->ultimo_instante = realloc(curva->ultimo_instante, nova * sizeof(size_t));
+        curva->maior_desde_escrita = realloc(curva->maior_desde_escrita, nova * sizeof(int));
+        // Distâncias vão até num_paginas; a diferença de escritas usa uma posição extra
+        curva->acessos_por_distancia = realloc(curva->acessos_por_distancia, (nova + 2) * sizeof(unsigned long));
+        curva->diferenca_escritas = realloc(curva->diferenca_escritas, (nova + 2) * sizeof(long));
+        memset(curva->acessos_por_distancia + antiga + 2, 0, (nova - antiga) * sizeof(unsigned long));
+        memset(curva->diferenca_escritas + antiga + 2, 0, (nova - antiga) * sizeof(long));
+        curva->capacidade_paginas = nova;
+    }
+    int id = (int)curva->num_paginas++;
+    curva->maior_desde_escrita[id] = -1;
+    mapa_paginas_inserir(curva->id_da_pagina, numero_pagina, id);
+    return id;
+}
+
+CurvaLRU* curva_lru_criar(void) {
+    CurvaLRU* curva = calloc(1, sizeof(CurvaLRU));
+    curva->id_da_pagina = mapa_paginas_criar(CAPACIDADE_INICIAL);
+
+    curva->capacidade_paginas = CAPACIDADE_INICIAL;
+    curva->ultimo_instante = malloc(CAPACIDADE_INICIAL * sizeof(size_t));
+    curva->maior_desde_escrita = malloc(CAPACIDADE_INICIAL * sizeof(int));
+    curva->acessos_por_distancia = calloc(CAPACIDADE_INICIAL + 2, sizeof(unsigned long));
+    curva->diferenca_escritas = calloc(CAPACIDADE_INICIAL + 2, sizeof(long));
+
+    curva->capacidade_instantes = CAPACIDADE_INICIAL * 2;
+    curva->arvore = calloc(curva->capacidade_instantes + 1, sizeof(int));
+    curva->pagina_no_instante = malloc(curva->capacidade_instantes * sizeof(int));
+    for (size_t t = 0; t < curva->capacidade_instantes; t++) curva->pagina_no_instante[t] = -1;
+    return curva;
+}
+
+void curva_lru_acessar(CurvaLRU* curva, uint32_t numero_pagina, char tipo_acesso) {
+    curva->total_acessos++;
+    if (curva->instante == curva->capacidade_instantes) compactar_instantes(curva);
+
+    int id;
+    if (mapa_paginas_buscar(curva->id_da_pagina, numero_pagina, &id)) {
+        size_t ultimo = curva->ultimo_instante[id];
+        long distancia = fenwick_prefixo(curva, curva->instante) - fenwick_prefixo(curva, ultimo + 1) + 1;
+        curva->acessos_por_distancia[distancia]++;
+
+        // Escrita da página suja em toda memória com maior_desde_escrita <= C < distancia
+        int maior = curva->maior_desde_escrita[id];
+        if (maior >= 0) {
+            long inicio = maior > 0 ? maior : 1;
+            if (inicio < distancia) {
+                curva->diferenca_escritas[inicio]++;
+                curva->diferenca_escritas[distancia]--;
+            }
+            if (distancia > maior) curva->maior_desde_escrita[id] = (int)distancia;
+        }
+
+        fenwick_somar(curva, ultimo, -1);
+        curva->pagina_no_instante[ultimo] = -1;
+    } else {
+        id = nova_pagina(curva, numero_pagina);
+        curva->faltas_compulsorias++;
+    }
+
+    if (tipo_acesso == 'W') curva->maior_desde_escrita[id] = 0;
+    curva->ultimo_instante[id] = curva->instante;
+    curva->pagina_no_instante[curva->instante] = id;
+    fenwick_somar(curva, curva->instante, 1);
+    curva->instante++;
+}
+
+void curva_lru_imprimir(CurvaLRU* curva, FILE* out, int tam_pagina_kb, size_t max_quadros) {
+    size_t limite = curva->num_paginas;
+    if (max_quadros > 0 && max_quadros < limite) limite = max_quadros;
+
+    // Faltas com C quadros: compulsórias + acessos com distância > C
+    unsigned long acima = 0;
+    for (size_t d = limite + 1; d <= curva->num_paginas; d++) acima += curva->acessos_por_distancia[d];
+    unsigned long* faltas = malloc((limite + 1) * sizeof(unsigned long));
+    for (size_t c = limite; c >= 1; c--) {
+        faltas[c] = curva->faltas_compulsorias + acima;
+        acima += curva->acessos_por_distancia[c];
+    }
+
+    // Páginas sujas que não voltam a ser acessadas também são escritas ao serem
+    // expulsas: isso ocorre em toda memória menor que 1 + o número de páginas
+    // distintas acessadas depois do último acesso a elas
+    long* diferenca = malloc((curva->num_paginas + 2) * sizeof(long));
+    memcpy(diferenca, curva->diferenca_escritas, (curva->num_paginas + 2) * sizeof(long));
+    for (size_t id = 0; id < curva->num_paginas; id++) {
+        int maior = curva->maior_desde_escrita[id];
+        if (maior < 0) continue;
+        size_t ultimo = curva->ultimo_instante[id];
+        long distancia = fenwick_prefixo(curva, curva->instante) - fenwick_prefixo(curva, ultimo + 1) + 1;
+        long inicio = maior > 0 ? maior : 1;
+        if (inicio < distancia) {
+            diferenca[inicio]++;
+            diferenca[distancia]--;
+        }
+    }
+
+    fprintf(out, "quadros,memoria_kb,page_faults,taxa_faltas,paginas_escritas\n");
+    long escritas = 0;
+    for (size_t c = 1; c <= limite; c++) {
+        escritas += diferenca[c];
+        fprintf(out, "%zu,%lu,%lu,%.6f,%ld\n", c, (unsigned long)c * (unsigned long)tam_pagina_kb, faltas[c],
+                curva->total_acessos ? (double)faltas[c] / (double)curva->total_acessos : 0.0, escritas);
+    }
+    free(faltas);
+    free(diferenca);
+}
+
+void curva_lru_destruir(CurvaLRU* curva) {
+    if (curva == NULL) return;
+    mapa_paginas_destruir(curva->id_da_pagina);
+    free(curva->ultimo_instante);
+    free(curva->maior_desde_escrita);
+    free(curva->arvore);
+    free(curva->pagina_no_instante);
+    free(curva->acessos_por_distancia);
+    free(curva->diferenca_escritas);
+    free(curva);
+}
@@ -0,0 +1,55 @@
+#ifndef MRC_H
+#define MRC_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "mapa_paginas.h"
+
+// Curva de faltas do LRU para todos os tamanhos de memória em uma única passada
+// (algoritmo de pilha de Mattson). Para cada acesso calcula-se a distância de
+// reuso: quantas páginas distintas foram acessadas desde o último acesso à mesma
+// página. Com C quadros, o acesso é hit se e somente se a distância for <= C.
+// As distâncias são contadas com uma árvore de Fenwick sobre os instantes do
+// último acesso de cada página, em O(log M) por acesso (M = páginas distintas).
+//
+// As escritas de páginas sujas também são exatas: entre dois acessos a uma página
+// com distância d, ela é expulsa em toda memória com C < d quadros, e está suja
+// se não houve nova carga desde a última escrita, isto é, se todas as distâncias
+// desde a escrita foram <= C
+
+typedef struct {
+    MapaPaginas* id_da_pagina;   // página -> índice denso da página
+
+    // Por página (índice denso)
+    size_t* ultimo_instante;     // instante do último acesso
+    int* maior_desde_escrita;    // maior distância desde a última escrita (-1 se limpa)
+    size_t num_paginas;
+    size_t capacidade_paginas;
+
+    // Árvore de Fenwick sobre os instantes: 1 no último acesso de cada página
+    int* arvore;
+    int* pagina_no_instante;     // -1 se o instante não é mais o último acesso de ninguém
+    size_t capacidade_instantes;
+    size_t instante;
+
+    // Por distância de reuso (1..num_paginas)
+    unsigned long* acessos_por_distancia;
+    long* diferenca_escritas;    // escritas(C) = soma de diferenca_escritas[1..C]
+
+    unsigned long faltas_compulsorias;
+    unsigned long total_acessos;
+} CurvaLRU;
+
+CurvaLRU* curva_lru_criar(void);
+
+// Processa um acesso à página ('R' ou 'W')
+void curva_lru_acessar(CurvaLRU* curva, uint32_t numero_pagina, char tipo_acesso);
+
+// Imprime a curva em CSV (quadros, memória, faltas, taxa de faltas, escritas)
+// para 1..max_quadros quadros (0 = até o número de páginas distintas)
+void curva_lru_imprimir(CurvaLRU* curva, FILE* out, int tam_pagina_kb, size_t max_quadros);
+
+void curva_lru_destruir(CurvaLRU* curva);
+
+#endif
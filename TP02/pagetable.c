@@ -1,7 +1,14 @@
+#define _DEFAULT_SOURCE
+
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/mman.h>
 #include "pagetable.h"
+#include "arena.h"
+#include "instrumentacao.h"
 
 // --- IMPLEMENTAÇÃO: TABELA DENSA (1 NÍVEL) ---
 
@@ -45,7 +52,7 @@ size_t memory_cost_densa(PageTable* pt) {
 }
 
 PageTable* pagetable_densa_create(int page_shift) {
-    PageTable* pt = malloc(sizeof(PageTable));
+    PageTable* pt = calloc(1, sizeof(PageTable));
     DensePageTable* impl = malloc(sizeof(DensePageTable));
 
     pt->impl = impl;
@@ -53,6 +60,7 @@ PageTable* pagetable_densa_create(int page_shift) {
     pt->update = update_densa;
     pt->destroy = destroy_densa;
     pt->memory_cost = memory_cost_densa;
+    pt->print_stats = NULL;
 
     impl->num_entries = 1L << (32 - page_shift);
     impl->entries = calloc(impl->num_entries, sizeof(PTE_Densa));
@@ -64,6 +72,84 @@ PageTable* pagetable_densa_create(int page_shift) {
 }
 
 
+// --- IMPLEMENTAÇÃO: TABELA DENSA COM RESERVA VIRTUAL ---
+// Mesmo vetor da tabela densa, mas reservado com mmap(MAP_NORESERVE) em vez de
+// calloc. O kernel só aloca as páginas do vetor que forem de fato escritas;
+// as demais são lidas como zero (PTE inválida) sem ocupar memória física
+
+// A tabela densa vem primeiro, então lookup, update e memory_cost da densa
+// (que convertem pt->impl para DensePageTable*) servem também para esta
+typedef struct {
+    DensePageTable dense;
+    size_t reserved_bytes;
+} VirtualDensePageTable;
+
+void destroy_densa_virtual(PageTable* pt) {
+    VirtualDensePageTable* impl = (VirtualDensePageTable*)pt->impl;
+    munmap(impl->dense.entries, impl->reserved_bytes);
+    free(impl);
+    free(pt);
+}
+
+// Memória residente do processo inteiro, lida de /proc/self/statm. Retorna 0 se indisponível
+static size_t process_resident_bytes(void) {
+    FILE* statm = fopen("/proc/self/statm", "r");
+    unsigned long total, resident;
+    size_t bytes = 0;
+    if (statm == NULL) return 0;
+    if (fscanf(statm, "%lu %lu", &total, &resident) == 2) {
+        bytes = (size_t)resident * (size_t)sysconf(_SC_PAGESIZE);
+    }
+    fclose(statm);
+    return bytes;
+}
+
+void print_stats_densa_virtual(PageTable* pt, FILE* out) {
+    VirtualDensePageTable* impl = (VirtualDensePageTable*)pt->impl;
+    size_t os_page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t num_os_pages = (impl->reserved_bytes + os_page - 1) / os_page;
+    unsigned char* residency = malloc(num_os_pages);
+    size_t resident = 0;
+
+    if (residency && mincore(impl->dense.entries, impl->reserved_bytes, residency) == 0) {
+        for (size_t i = 0; i < num_os_pages; i++) resident += residency[i] & 1;
+        fprintf(out, "  Memória residente da tabela (mincore): %.2f KB de %.2f KB reservados (%zu de %zu páginas)\n",
+                (double)(resident * os_page) / 1024.0, (double)impl->reserved_bytes / 1024.0,
+                resident, num_os_pages);
+    }
+    free(residency);
+
+    size_t rss = process_resident_bytes();
+    if (rss > 0) {
+        fprintf(out, "  Memória residente do processo (RSS): %.2f KB\n", (double)rss / 1024.0);
+    }
+}
+
+PageTable* pagetable_densa_virtual_create(int page_shift) {
+    PageTable* pt = calloc(1, sizeof(PageTable));
+    VirtualDensePageTable* impl = malloc(sizeof(VirtualDensePageTable));
+
+    pt->impl = impl;
+    // O custo modelado é o do vetor completo, como na tabela densa
+    pt->lookup = lookup_densa;
+    pt->update = update_densa;
+    pt->destroy = destroy_densa_virtual;
+    pt->memory_cost = memory_cost_densa;
+    pt->print_stats = print_stats_densa_virtual;
+
+    impl->dense.num_entries = 1L << (32 - page_shift);
+    impl->reserved_bytes = impl->dense.num_entries * sizeof(PTE_Densa);
+    void* reservation = mmap(NULL, impl->reserved_bytes, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (reservation == MAP_FAILED) {
+        perror("Falha ao reservar a tabela de páginas densa virtual");
+        exit(EXIT_FAILURE);
+    }
+    impl->dense.entries = (PTE_Densa*)reservation;
+    return pt;
+}
+
+
 // --- IMPLEMENTAÇÃO: TABELA HIERÁRQUICA (2 E 3 NÍVEIS) ---
 
 typedef struct {
@@ -71,6 +157,9 @@ typedef struct {
     int valid;
 } PTE_Hierarquica;
 
+// Tabelas de nível inferior por bloco das arenas das tabelas hierárquicas
+#define PT_TABLES_PER_BLOCK 16
+
 typedef struct HierarchicalPageTable {
     PTE_Hierarquica* root;
     int levels;
@@ -78,6 +167,18 @@ typedef struct HierarchicalPageTable {
     int shifts[3];
     size_t allocated_tables_count;
     size_t entries_per_table[3];
+    Arena arena; // tabelas de todos os níveis
+
+    // Cache de caminhada (page-walk cache), opcional: para cada nível
+    // intermediário, guarda o ponteiro da tabela do nível seguinte indexado pelos
+    // bits superiores da página. É mapeado diretamente (prefixo & máscara)
+    int pwc_entries;                       // 0: desativado; potência de 2
+    unsigned int* pwc_tags[2];             // prefixo + 1 (0 = posição vazia)
+    PTE_Hierarquica** pwc_tables[2];
+    unsigned long pwc_lookups;
+    unsigned long pwc_hits[2];
+    unsigned long pwc_walk_cost;           // acessos feitos com o cache
+    unsigned long pwc_saved_cost;          // acessos evitados pelo cache
 } HierarchicalPageTable;
 
 int lookup_hierarquica(PageTable* pt, unsigned int page_num, int* cost) {
@@ -123,7 +224,7 @@ void update_hierarquica(PageTable* pt, unsigned int page_num, int frame_num) {
     PTE_Hierarquica* level1_table = impl->root;
     if (!level1_table[idxs[0]].valid) {
         if(is_invalidation) return;
-        level1_table[idxs[0]].next_level_or_frame = calloc(impl->entries_per_table[1], sizeof(PTE_Hierarquica));
+        level1_table[idxs[0]].next_level_or_frame = arena_alocar(&impl->arena, impl->entries_per_table[1] * sizeof(PTE_Hierarquica));
         level1_table[idxs[0]].valid = 1;
         impl->allocated_tables_count++;
     }
@@ -139,7 +240,7 @@ void update_hierarquica(PageTable* pt, unsigned int page_num, int frame_num) {
     
     if (!level2_table[idxs[1]].valid) {
         if(is_invalidation) return;
-        level2_table[idxs[1]].next_level_or_frame = calloc(impl->entries_per_table[2], sizeof(PTE_Hierarquica));
+        level2_table[idxs[1]].next_level_or_frame = arena_alocar(&impl->arena, impl->entries_per_table[2] * sizeof(PTE_Hierarquica));
         level2_table[idxs[1]].valid = 1;
         impl->allocated_tables_count++;
     }
@@ -150,20 +251,55 @@ void update_hierarquica(PageTable* pt, unsigned int page_num, int frame_num) {
     level3_table[idxs[2]].valid = !is_invalidation;
 }
 
-void destroy_hierarquica_recursive(PTE_Hierarquica* table, int level, HierarchicalPageTable* impl) {
-    if (level >= impl->levels) return;
-    
-    for (size_t i = 0; i < impl->entries_per_table[level]; i++) {
-        if (table[i].valid) {
-            destroy_hierarquica_recursive((PTE_Hierarquica*)table[i].next_level_or_frame, level + 1, impl);
+// Consulta com o cache de caminhada: começa pela tabela mais profunda que estiver
+// no cache. As tabelas intermediárias nunca são liberadas antes da destruição,
+// então os ponteiros guardados não precisam ser invalidados
+int lookup_hierarquica_pwc(PageTable* pt, unsigned int page_num, int* cost) {
+    HierarchicalPageTable* impl = (HierarchicalPageTable*)pt->impl;
+    size_t pwc_mask = (size_t)impl->pwc_entries - 1;
+    PTE_Hierarquica* table = impl->root;
+    int start = 0;
+
+    impl->pwc_lookups++;
+    for (int level = impl->levels - 2; level >= 0; level--) {
+        unsigned int prefix = page_num >> impl->shifts[level];
+        size_t slot = prefix & pwc_mask;
+        if (impl->pwc_tags[level][slot] == prefix + 1) {
+            table = impl->pwc_tables[level][slot];
+            start = level + 1;
+            impl->pwc_hits[level]++;
+            break;
+        }
+    }
+    impl->pwc_saved_cost += (unsigned long)start;
+
+    *cost = 0;
+    for (int level = start; level < impl->levels; level++) {
+        (*cost)++;
+        PTE_Hierarquica* entry = &table[(page_num >> impl->shifts[level]) & impl->masks[level]];
+        if (!entry->valid) break;
+        if (level == impl->levels - 1) {
+            impl->pwc_walk_cost += (unsigned long)*cost;
+            return (int)(long)entry->next_level_or_frame;
         }
+
+        table = (PTE_Hierarquica*)entry->next_level_or_frame;
+        unsigned int prefix = page_num >> impl->shifts[level];
+        size_t slot = prefix & pwc_mask;
+        impl->pwc_tags[level][slot] = prefix + 1;
+        impl->pwc_tables[level][slot] = table;
     }
-    free(table);
+    impl->pwc_walk_cost += (unsigned long)*cost;
+    return -1;
 }
 
 void destroy_hierarquica(PageTable* pt) {
     HierarchicalPageTable* impl = (HierarchicalPageTable*)pt->impl;
-    destroy_hierarquica_recursive(impl->root, 1, impl);
+    arena_liberar_tudo(&impl->arena);
+    for (int i = 0; i < 2; i++) {
+        free(impl->pwc_tags[i]);
+        free(impl->pwc_tables[i]);
+    }
     free(impl);
     free(pt);
 }
@@ -173,19 +309,36 @@ size_t memory_cost_hierarquica(PageTable* pt) {
     return impl->allocated_tables_count * impl->entries_per_table[0] * sizeof(PTE_Hierarquica);
 }
 
-PageTable* pagetable_hierarquica_create(int levels, int page_shift) {
-    PageTable* pt = malloc(sizeof(PageTable));
-    HierarchicalPageTable* impl = malloc(sizeof(HierarchicalPageTable));
-    pt->impl = impl;
-    pt->lookup = lookup_hierarquica;
-    pt->update = update_hierarquica;
-    pt->destroy = destroy_hierarquica;
-    pt->memory_cost = memory_cost_hierarquica;
+// Memória efetivamente obtida do sistema pela arena de uma tabela
+static void print_stats_arena(FILE* out, const Arena* arena) {
+    fprintf(out, "  Arena da tabela: %.2f KB reservados em %zu blocos\n",
+            (double)arena->bytes_reservados / 1024.0, arena->num_blocos);
+}
 
-    impl->levels = levels;
+void print_stats_hierarquica(PageTable* pt, FILE* out) {
+    HierarchicalPageTable* impl = (HierarchicalPageTable*)pt->impl;
+    print_stats_arena(out, &impl->arena);
+    if (impl->pwc_entries == 0) return;
+
+    double lookups = impl->pwc_lookups ? (double)impl->pwc_lookups : 1.0;
+    unsigned long full_cost = impl->pwc_walk_cost + impl->pwc_saved_cost;
+    fprintf(out, "Cache de Caminhada (PWC):\n");
+    fprintf(out, "  Configuração: %d entradas por nível intermediário (mapeamento direto)\n", impl->pwc_entries);
+    for (int level = impl->levels - 2; level >= 0; level--) {
+        fprintf(out, "  Acertos levando direto ao nível %d: %.2f%%\n",
+                level + 2, 100.0 * (double)impl->pwc_hits[level] / lookups);
+    }
+    fprintf(out, "  Custo médio de caminhada sem PWC: %.3f acessos\n", (double)full_cost / lookups);
+    fprintf(out, "  Custo médio de caminhada com PWC: %.3f acessos (redução de %.1f%%)\n",
+            (double)impl->pwc_walk_cost / lookups,
+            full_cost ? 100.0 * (double)impl->pwc_saved_cost / (double)full_cost : 0.0);
+}
+
+// Divide os bits do número da página entre os níveis (2 ou 3); o último nível
+// fica com o resto da divisão. Compartilhada pelas versões comum e compacta
+static void hierarquica_dividir_bits(int levels, int page_shift, int masks[3], int shifts[3],
+                                     size_t entries_per_table[3]) {
     int page_num_bits = 32 - page_shift;
-    
-    // --- LÓGICA DE DIVISÃO DE BITS CORRIGIDA ---
     int bits[3];
     if (levels == 2) {
         bits[0] = page_num_bits / 2;
@@ -197,21 +350,254 @@ PageTable* pagetable_hierarquica_create(int levels, int page_shift) {
         bits[2] = page_num_bits - (bits[0] + bits[1]);
     }
 
-    impl->shifts[2] = 0;
-    impl->shifts[1] = bits[2];
-    impl->shifts[0] = bits[1] + bits[2];
-    
-    for(int i=0; i<3; i++){
-        impl->masks[i] = (1 << bits[i]) - 1;
-        impl->entries_per_table[i] = (1 << bits[i]);
+    shifts[2] = 0;
+    shifts[1] = bits[2];
+    shifts[0] = bits[1] + bits[2];
+
+    for (int i = 0; i < 3; i++) {
+        masks[i] = (1 << bits[i]) - 1;
+        entries_per_table[i] = (1 << bits[i]);
     }
-    
-    impl->root = calloc(impl->entries_per_table[0], sizeof(PTE_Hierarquica));
+}
+
+PageTable* pagetable_hierarquica_create(int levels, int page_shift) {
+    PageTable* pt = calloc(1, sizeof(PageTable));
+    HierarchicalPageTable* impl = calloc(1, sizeof(HierarchicalPageTable));
+    pt->impl = impl;
+    pt->lookup = lookup_hierarquica;
+    pt->update = update_hierarquica;
+    pt->destroy = destroy_hierarquica;
+    pt->memory_cost = memory_cost_hierarquica;
+    pt->print_stats = print_stats_hierarquica;
+
+    impl->levels = levels;
+    hierarquica_dividir_bits(levels, page_shift, impl->masks, impl->shifts, impl->entries_per_table);
+
+    // Cada bloco da arena comporta várias tabelas do maior nível inferior
+    size_t largest_child = impl->entries_per_table[1] > impl->entries_per_table[2] ?
+                           impl->entries_per_table[1] : impl->entries_per_table[2];
+    arena_iniciar(&impl->arena, PT_TABLES_PER_BLOCK * largest_child * sizeof(PTE_Hierarquica));
+    impl->root = arena_alocar(&impl->arena, impl->entries_per_table[0] * sizeof(PTE_Hierarquica));
     impl->allocated_tables_count = 1;
 
     return pt;
 }
 
+PageTable* pagetable_hierarquica_pwc_create(int levels, int page_shift, int pwc_entries) {
+    PageTable* pt = pagetable_hierarquica_create(levels, page_shift);
+    HierarchicalPageTable* impl = (HierarchicalPageTable*)pt->impl;
+    if (pwc_entries <= 0) return pt;
+
+    // Arredonda para potência de 2
+    impl->pwc_entries = 1;
+    while (impl->pwc_entries < pwc_entries) impl->pwc_entries *= 2;
+    for (int level = 0; level < levels - 1; level++) {
+        impl->pwc_tags[level] = calloc(impl->pwc_entries, sizeof(unsigned int));
+        impl->pwc_tables[level] = calloc(impl->pwc_entries, sizeof(PTE_Hierarquica*));
+    }
+    pt->lookup = lookup_hierarquica_pwc;
+    return pt;
+}
+
+
+// --- IMPLEMENTAÇÃO: ENTRADAS COMPACTAS (DENSA E HIERÁRQUICA) ---
+// O bit de validade é embutido no próprio valor: a entrada guarda quadro + 1
+// (ou, nos níveis intermediários, o índice da tabela filha) e 0 significa
+// inválida. A largura, 16 ou 32 bits, é escolhida na criação pelo maior valor
+// que a tabela precisará guardar
+
+typedef struct {
+    void* entries;
+    int wide;          // 1: entradas de 32 bits; 0: 16 bits
+    size_t num_entries;
+} CompactDensePageTable;
+
+static inline uint32_t compact_get(const void* table, size_t i, int wide) {
+    return wide ? ((const uint32_t*)table)[i] : ((const uint16_t*)table)[i];
+}
+
+static inline void compact_set(void* table, size_t i, int wide, uint32_t value) {
+    if (wide) ((uint32_t*)table)[i] = value;
+    else ((uint16_t*)table)[i] = (uint16_t)value;
+}
+
+static inline size_t compact_width(int wide) {
+    return wide ? sizeof(uint32_t) : sizeof(uint16_t);
+}
+
+// 16 bits bastam se o maior valor (mais o 0 reservado) couber em uma entrada
+static int compact_needs_wide(size_t max_value) {
+    return max_value + 1 > UINT16_MAX;
+}
+
+static void print_stats_compact(FILE* out, int wide) {
+    fprintf(out, "  Entradas compactas de %d bits (validade embutida no valor)\n", wide ? 32 : 16);
+}
+
+int lookup_densa_compacta(PageTable* pt, unsigned int page_num, int* cost) {
+    CompactDensePageTable* impl = (CompactDensePageTable*)pt->impl;
+    *cost = 1;
+    if (page_num >= impl->num_entries) return -1;
+    return (int)compact_get(impl->entries, page_num, impl->wide) - 1;
+}
+
+void update_densa_compacta(PageTable* pt, unsigned int page_num, int frame_num) {
+    CompactDensePageTable* impl = (CompactDensePageTable*)pt->impl;
+    if (page_num < impl->num_entries) {
+        compact_set(impl->entries, page_num, impl->wide, (uint32_t)(frame_num + 1));
+    }
+}
+
+void destroy_densa_compacta(PageTable* pt) {
+    CompactDensePageTable* impl = (CompactDensePageTable*)pt->impl;
+    free(impl->entries);
+    free(impl);
+    free(pt);
+}
+
+size_t memory_cost_densa_compacta(PageTable* pt) {
+    CompactDensePageTable* impl = (CompactDensePageTable*)pt->impl;
+    return impl->num_entries * compact_width(impl->wide);
+}
+
+void print_stats_densa_compacta(PageTable* pt, FILE* out) {
+    print_stats_compact(out, ((CompactDensePageTable*)pt->impl)->wide);
+}
+
+PageTable* pagetable_densa_compacta_create(int page_shift, int num_frames) {
+    PageTable* pt = calloc(1, sizeof(PageTable));
+    CompactDensePageTable* impl = malloc(sizeof(CompactDensePageTable));
+
+    pt->impl = impl;
+    pt->lookup = lookup_densa_compacta;
+    pt->update = update_densa_compacta;
+    pt->destroy = destroy_densa_compacta;
+    pt->memory_cost = memory_cost_densa_compacta;
+    pt->print_stats = print_stats_densa_compacta;
+
+    impl->wide = compact_needs_wide((size_t)num_frames);
+    impl->num_entries = 1L << (32 - page_shift);
+    impl->entries = calloc(impl->num_entries, compact_width(impl->wide));
+    if (!impl->entries) {
+        perror("Falha ao alocar tabela de páginas densa compacta (memória insuficiente)");
+        exit(EXIT_FAILURE);
+    }
+    return pt;
+}
+
+// Nos níveis intermediários, a entrada guarda o índice da tabela filha em
+// 'tables' (a raiz é a tabela 0, então 0 continua significando inválida). O
+// índice faz o papel do endereço físico que uma PTE de hardware guardaria
+typedef struct {
+    void** tables;
+    size_t tables_capacity;
+    size_t allocated_tables_count;
+    int wide;
+    int levels;
+    int masks[3];
+    int shifts[3];
+    size_t entries_per_table[3];
+    size_t allocated_bytes;
+    Arena arena;
+} CompactHierarchicalPageTable;
+
+int lookup_hierarquica_compacta(PageTable* pt, unsigned int page_num, int* cost) {
+    CompactHierarchicalPageTable* impl = (CompactHierarchicalPageTable*)pt->impl;
+    int wide = impl->wide;
+    void* table = impl->tables[0];
+
+    *cost = 0;
+    for (int level = 0; level < impl->levels; level++) {
+        (*cost)++;
+        uint32_t entry = compact_get(table, (page_num >> impl->shifts[level]) & impl->masks[level], wide);
+        if (entry == 0) return -1;
+        if (level == impl->levels - 1) return (int)entry - 1;
+        table = impl->tables[entry];
+    }
+    return -1;
+}
+
+static uint32_t hierarquica_compacta_new_table(CompactHierarchicalPageTable* impl, int level) {
+    if (impl->allocated_tables_count == impl->tables_capacity) {
+        impl->tables_capacity *= 2;
+        impl->tables = realloc(impl->tables, impl->tables_capacity * sizeof(void*));
+    }
+    size_t bytes = impl->entries_per_table[level] * compact_width(impl->wide);
+    impl->tables[impl->allocated_tables_count] = arena_alocar(&impl->arena, bytes);
+    impl->allocated_bytes += bytes;
+    return (uint32_t)impl->allocated_tables_count++;
+}
+
+void update_hierarquica_compacta(PageTable* pt, unsigned int page_num, int frame_num) {
+    CompactHierarchicalPageTable* impl = (CompactHierarchicalPageTable*)pt->impl;
+    int wide = impl->wide;
+    void* table = impl->tables[0];
+
+    for (int level = 0; level < impl->levels - 1; level++) {
+        size_t idx = (page_num >> impl->shifts[level]) & impl->masks[level];
+        uint32_t child = compact_get(table, idx, wide);
+        if (child == 0) {
+            if (frame_num == -1) return;
+            child = hierarquica_compacta_new_table(impl, level + 1);
+            compact_set(table, idx, wide, child);
+        }
+        table = impl->tables[child];
+    }
+    int last = impl->levels - 1;
+    compact_set(table, (page_num >> impl->shifts[last]) & impl->masks[last], wide, (uint32_t)(frame_num + 1));
+}
+
+void destroy_hierarquica_compacta(PageTable* pt) {
+    CompactHierarchicalPageTable* impl = (CompactHierarchicalPageTable*)pt->impl;
+    arena_liberar_tudo(&impl->arena);
+    free(impl->tables);
+    free(impl);
+    free(pt);
+}
+
+size_t memory_cost_hierarquica_compacta(PageTable* pt) {
+    return ((CompactHierarchicalPageTable*)pt->impl)->allocated_bytes;
+}
+
+void print_stats_hierarquica_compacta(PageTable* pt, FILE* out) {
+    CompactHierarchicalPageTable* impl = (CompactHierarchicalPageTable*)pt->impl;
+    print_stats_compact(out, impl->wide);
+    fprintf(out, "  Tabelas alocadas: %zu\n", impl->allocated_tables_count);
+    print_stats_arena(out, &impl->arena);
+}
+
+PageTable* pagetable_hierarquica_compacta_create(int levels, int page_shift, int num_frames) {
+    PageTable* pt = calloc(1, sizeof(PageTable));
+    CompactHierarchicalPageTable* impl = calloc(1, sizeof(CompactHierarchicalPageTable));
+    pt->impl = impl;
+    pt->lookup = lookup_hierarquica_compacta;
+    pt->update = update_hierarquica_compacta;
+    pt->destroy = destroy_hierarquica_compacta;
+    pt->memory_cost = memory_cost_hierarquica_compacta;
+    pt->print_stats = print_stats_hierarquica_compacta;
+
+    impl->levels = levels;
+    hierarquica_dividir_bits(levels, page_shift, impl->masks, impl->shifts, impl->entries_per_table);
+
+    // A entrada precisa guardar tanto quadros quanto índices de tabelas
+    size_t max_tables = 1;
+    size_t tables_in_level = 1;
+    for (int i = 0; i < levels - 1; i++) {
+        tables_in_level *= impl->entries_per_table[i];
+        max_tables += tables_in_level;
+    }
+    size_t max_value = max_tables > (size_t)num_frames ? max_tables : (size_t)num_frames;
+    impl->wide = compact_needs_wide(max_value);
+
+    size_t largest_child = impl->entries_per_table[1] > impl->entries_per_table[2] ?
+                           impl->entries_per_table[1] : impl->entries_per_table[2];
+    arena_iniciar(&impl->arena, PT_TABLES_PER_BLOCK * largest_child * compact_width(impl->wide));
+    impl->tables_capacity = 16;
+    impl->tables = malloc(impl->tables_capacity * sizeof(void*));
+    hierarquica_compacta_new_table(impl, 0);
+    return pt;
+}
+
 
 // --- IMPLEMENTAÇÃO: TABELA INVERTIDA (com Hashing) ---
 
@@ -221,10 +607,17 @@ typedef struct IPT_Node {
     struct IPT_Node* next;
 } IPT_Node;
 
+// Nós por bloco da arena da tabela invertida
+#define IPT_NODES_PER_BLOCK 4096
+
 typedef struct {
     IPT_Node** buckets;
     int num_buckets;
     size_t node_count;
+    IPT_Node** node_by_frame; // Índice reverso: nó que mapeia cada quadro (ou NULL)
+    int num_frames;
+    Arena arena;
+    Slab nodes; // nós reaproveitados entre page faults
 } InvertedPageTable;
 
 int lookup_invertida(PageTable* pt, unsigned int page_num, int* cost) {
@@ -234,71 +627,64 @@ int lookup_invertida(PageTable* pt, unsigned int page_num, int* cost) {
     *cost = 1; // Custo do hash + acesso inicial
     while (current) {
         if (current->page_num == page_num) {
+            INSTR_SONDAGEM(pt, *cost);
             return current->frame_num;
         }
         current = current->next;
         (*cost)++; // Custo por cada passo na lista ligada
     }
+    INSTR_SONDAGEM(pt, *cost - 1);
     return -1; // Page Fault
 }
 
+// Remove o nó da lista do seu bucket e do índice reverso
+static void remove_node_invertida(InvertedPageTable* impl, IPT_Node* node) {
+    int bucket = node->page_num % impl->num_buckets;
+    IPT_Node** link = &impl->buckets[bucket];
+    while (*link != node) link = &(*link)->next;
+    *link = node->next;
+
+    if (impl->node_by_frame[node->frame_num] == node) {
+        impl->node_by_frame[node->frame_num] = NULL;
+    }
+    slab_liberar(&impl->nodes, node);
+    impl->node_count--;
+}
+
 void update_invertida(PageTable* pt, unsigned int page_num, int frame_num) {
     InvertedPageTable* impl = (InvertedPageTable*)pt->impl;
     int bucket = page_num % impl->num_buckets;
 
     IPT_Node* current = impl->buckets[bucket];
-    IPT_Node* prev = NULL;
-    while(current) {
+    while (current) {
         if (current->page_num == page_num) {
-            if (prev) prev->next = current->next;
-            else impl->buckets[bucket] = current->next;
-            free(current);
-            impl->node_count--;
+            remove_node_invertida(impl, current);
             break;
         }
-        prev = current;
         current = current->next;
     }
 
     if (frame_num != -1) {
-        // Invalida mapeamento antigo para o frame
-        for (int i = 0; i < impl->num_buckets; i++) {
-             current = impl->buckets[i];
-             prev = NULL;
-            while(current) {
-                if (current->frame_num == frame_num) {
-                    if (prev) prev->next = current->next;
-                    else impl->buckets[i] = current->next;
-                    free(current);
-                    impl->node_count--;
-                    current = NULL; // Sai do while interno
-                } else {
-                    prev = current;
-                    current = current->next;
-                }
-            }
+        // Invalida mapeamento antigo para o frame, localizado pelo índice reverso
+        if (impl->node_by_frame[frame_num]) {
+            remove_node_invertida(impl, impl->node_by_frame[frame_num]);
         }
         // Adiciona novo mapeamento
-        IPT_Node* new_node = malloc(sizeof(IPT_Node));
+        IPT_Node* new_node = slab_alocar(&impl->nodes);
         new_node->page_num = page_num;
         new_node->frame_num = frame_num;
         new_node->next = impl->buckets[bucket];
         impl->buckets[bucket] = new_node;
+        impl->node_by_frame[frame_num] = new_node;
         impl->node_count++;
     }
 }
 
 void destroy_invertida(PageTable* pt) {
     InvertedPageTable* impl = (InvertedPageTable*)pt->impl;
-    for (int i = 0; i < impl->num_buckets; i++) {
-        IPT_Node* current = impl->buckets[i];
-        while (current) {
-            IPT_Node* tmp = current;
-            current = current->next;
-            free(tmp);
-        }
-    }
+    arena_liberar_tudo(&impl->arena);
     free(impl->buckets);
+    free(impl->node_by_frame);
     free(impl);
     free(pt);
 }
@@ -306,22 +692,307 @@ void destroy_invertida(PageTable* pt) {
 size_t memory_cost_invertida(PageTable* pt) {
     InvertedPageTable* impl = (InvertedPageTable*)pt->impl;
     size_t cost = impl->num_buckets * sizeof(IPT_Node*);
+    cost += impl->num_frames * sizeof(IPT_Node*);
     cost += impl->node_count * sizeof(IPT_Node);
     return cost;
 }
 
+void print_stats_invertida(PageTable* pt, FILE* out) {
+    print_stats_arena(out, &((InvertedPageTable*)pt->impl)->arena);
+}
+
 PageTable* pagetable_invertida_create(int num_frames) {
-     PageTable* pt = malloc(sizeof(PageTable));
+     PageTable* pt = calloc(1, sizeof(PageTable));
     InvertedPageTable* impl = malloc(sizeof(InvertedPageTable));
     pt->impl = impl;
     pt->lookup = lookup_invertida;
     pt->update = update_invertida;
     pt->destroy = destroy_invertida;
     pt->memory_cost = memory_cost_invertida;
+    pt->print_stats = print_stats_invertida;
     
     impl->num_buckets = num_frames * 2; 
     impl->buckets = calloc(impl->num_buckets, sizeof(IPT_Node*));
     impl->node_count = 0;
+    impl->num_frames = num_frames;
+    impl->node_by_frame = calloc(num_frames, sizeof(IPT_Node*));
+    // Nunca há mais nós que quadros
+    arena_iniciar(&impl->arena, IPT_NODES_PER_BLOCK * sizeof(IPT_Node));
+    slab_iniciar(&impl->nodes, &impl->arena, sizeof(IPT_Node));
     
     return pt;
+}
+
+
+// --- IMPLEMENTAÇÃO: TABELA INVERTIDA COM ENDEREÇAMENTO ABERTO ---
+// Tabela hash plana no estilo "Swiss table": cada posição tem um byte de
+// controle (vazia, removida ou 7 bits do hash da chave), e os bytes de controle
+// são agrupados de 8 em 8. Uma consulta carrega o grupo inteiro em uma palavra
+// de 64 bits e compara os 8 bytes de uma vez (SWAR), só lendo as entradas
+// cujos 7 bits coincidem. Não há alocação por page fault nem ponteiros a seguir
+
+#define IPTA_GROUP_SIZE 8
+#define IPTA_EMPTY   0x80
+#define IPTA_DELETED 0xFE
+#define IPTA_LSBS 0x0101010101010101ULL
+#define IPTA_MSBS 0x8080808080808080ULL
+// Fator de carga máximo (entradas ocupadas + removidas) de 3/4
+#define IPTA_MAX_LOAD_NUM 3
+#define IPTA_MAX_LOAD_DEN 4
+
+typedef struct {
+    unsigned int page_num;
+    int frame_num;
+} IPTA_Slot;
+
+typedef struct {
+    uint8_t* ctrl;
+    IPTA_Slot* slots;
+    size_t capacity;        // potência de 2, múltiplo de IPTA_GROUP_SIZE
+    size_t group_mask;      // (capacity / IPTA_GROUP_SIZE) - 1
+    size_t size;            // entradas válidas
+    size_t growth_left;     // inserções em posições vazias antes de reconstruir
+    unsigned int* page_by_frame; // Índice reverso: página mapeada em cada quadro
+    uint8_t* frame_used;
+    int num_frames;
+
+    // Estatísticas de sondagem das consultas
+    unsigned long lookups;
+    unsigned long groups_probed;
+    unsigned long keys_compared;
+    unsigned long max_groups_probed;
+    unsigned long rehashes;
+} OpenInvertedPageTable;
+
+// Hash inteiro (finalizador do MurmurHash3)
+static inline uint32_t ipta_hash(unsigned int page_num) {
+    uint32_t h = page_num;
+    h ^= h >> 16;
+    h *= 0x85EBCA6BU;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35U;
+    h ^= h >> 16;
+    return h;
+}
+
+static inline uint64_t ipta_load_group(const uint8_t* ctrl) {
+    uint64_t g;
+    memcpy(&g, ctrl, sizeof(g));
+    return g;
+}
+
+// Bytes do grupo iguais a h2 (pode haver falsos positivos, sempre confirmados pela chave)
+static inline uint64_t ipta_match(uint64_t group, uint8_t h2) {
+    uint64_t x = group ^ (IPTA_LSBS * h2);
+    return (x - IPTA_LSBS) & ~x & IPTA_MSBS;
+}
+
+static inline uint64_t ipta_match_empty(uint64_t group) {
+    return group & ~(group << 6) & IPTA_MSBS;
+}
+
+static inline uint64_t ipta_match_empty_or_deleted(uint64_t group) {
+    return group & ~(group << 7) & IPTA_MSBS;
+}
+
+// Índice do byte correspondente ao bit menos significativo da máscara
+static inline int ipta_first_byte(uint64_t mask) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(mask) >> 3;
+#else
+    int i = 0;
+    while (!(mask & 0x80)) {
+        mask >>= 8;
+        i++;
+    }
+    return i;
+#endif
+}
+
+// Procura a posição da página. Retorna -1 se não estiver na tabela
+static long ipta_find(OpenInvertedPageTable* impl, unsigned int page_num,
+                      unsigned long* groups, unsigned long* keys) {
+    uint32_t h = ipta_hash(page_num);
+    uint8_t h2 = h & 0x7F;
+    size_t group = (h >> 7) & impl->group_mask;
+
+    for (size_t step = 1; ; step++) {
+        size_t base = group * IPTA_GROUP_SIZE;
+        uint64_t g = ipta_load_group(&impl->ctrl[base]);
+        (*groups)++;
+
+        for (uint64_t m = ipta_match(g, h2); m; m &= m - 1) {
+            size_t pos = base + ipta_first_byte(m);
+            (*keys)++;
+            if (impl->ctrl[pos] == h2 && impl->slots[pos].page_num == page_num) return (long)pos;
+        }
+        if (ipta_match_empty(g)) return -1;
+
+        // Sondagem triangular: percorre todos os grupos quando o número de grupos é potência de 2
+        group = (group + step) & impl->group_mask;
+    }
+}
+
+static void ipta_alloc(OpenInvertedPageTable* impl, size_t capacity) {
+    impl->capacity = capacity;
+    impl->group_mask = capacity / IPTA_GROUP_SIZE - 1;
+    impl->ctrl = malloc(capacity);
+    impl->slots = malloc(capacity * sizeof(IPTA_Slot));
+    memset(impl->ctrl, IPTA_EMPTY, capacity);
+    impl->size = 0;
+    impl->growth_left = capacity * IPTA_MAX_LOAD_NUM / IPTA_MAX_LOAD_DEN;
+}
+
+static void ipta_insert_new(OpenInvertedPageTable* impl, unsigned int page_num, int frame_num) {
+    uint32_t h = ipta_hash(page_num);
+    size_t group = (h >> 7) & impl->group_mask;
+
+    for (size_t step = 1; ; step++) {
+        size_t base = group * IPTA_GROUP_SIZE;
+        uint64_t free_mask = ipta_match_empty_or_deleted(ipta_load_group(&impl->ctrl[base]));
+        if (free_mask) {
+            size_t pos = base + ipta_first_byte(free_mask);
+            if (impl->ctrl[pos] == IPTA_EMPTY) impl->growth_left--;
+            impl->ctrl[pos] = h & 0x7F;
+            impl->slots[pos].page_num = page_num;
+            impl->slots[pos].frame_num = frame_num;
+            impl->size++;
+            return;
+        }
+        group = (group + step) & impl->group_mask;
+    }
+}
+
+// Reconstrói a tabela descartando as marcas de remoção, dobrando a capacidade se necessário
+static void ipta_rehash(OpenInvertedPageTable* impl) {
+    uint8_t* old_ctrl = impl->ctrl;
+    IPTA_Slot* old_slots = impl->slots;
+    size_t old_capacity = impl->capacity;
+
+    size_t capacity = old_capacity;
+    // Se mais da metade da carga máxima é de entradas válidas, reconstruir no
+    // mesmo tamanho liberaria pouco espaço: dobra a capacidade
+    if ((impl->size + 1) * IPTA_MAX_LOAD_DEN * 2 > capacity * IPTA_MAX_LOAD_NUM) {
+        capacity *= 2;
+    }
+    ipta_alloc(impl, capacity);
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (!(old_ctrl[i] & 0x80)) {
+            ipta_insert_new(impl, old_slots[i].page_num, old_slots[i].frame_num);
+        }
+    }
+    free(old_ctrl);
+    free(old_slots);
+    impl->rehashes++;
+}
+
+static void ipta_erase(OpenInvertedPageTable* impl, size_t pos) {
+    int frame_num = impl->slots[pos].frame_num;
+    impl->ctrl[pos] = IPTA_DELETED;
+    impl->size--;
+    if (frame_num >= 0 && frame_num < impl->num_frames) impl->frame_used[frame_num] = 0;
+}
+
+int lookup_invertida_aberta(PageTable* pt, unsigned int page_num, int* cost) {
+    OpenInvertedPageTable* impl = (OpenInvertedPageTable*)pt->impl;
+    unsigned long groups = 0, keys = 0;
+    long pos = ipta_find(impl, page_num, &groups, &keys);
+
+    // Custo: uma leitura por grupo de controle mais uma por entrada comparada
+    *cost = (int)(groups + keys);
+    impl->lookups++;
+    impl->groups_probed += groups;
+    impl->keys_compared += keys;
+    if (groups > impl->max_groups_probed) impl->max_groups_probed = groups;
+    INSTR_SONDAGEM(pt, groups);
+
+    return pos < 0 ? -1 : impl->slots[pos].frame_num;
+}
+
+void update_invertida_aberta(PageTable* pt, unsigned int page_num, int frame_num) {
+    OpenInvertedPageTable* impl = (OpenInvertedPageTable*)pt->impl;
+    unsigned long groups = 0, keys = 0;
+
+    long pos = ipta_find(impl, page_num, &groups, &keys);
+    if (pos >= 0) ipta_erase(impl, (size_t)pos);
+    if (frame_num == -1) return;
+
+    // Invalida mapeamento antigo para o frame
+    if (impl->frame_used[frame_num]) {
+        pos = ipta_find(impl, impl->page_by_frame[frame_num], &groups, &keys);
+        if (pos >= 0) ipta_erase(impl, (size_t)pos);
+    }
+
+    if (impl->growth_left == 0) ipta_rehash(impl);
+    ipta_insert_new(impl, page_num, frame_num);
+    impl->page_by_frame[frame_num] = page_num;
+    impl->frame_used[frame_num] = 1;
+}
+
+void destroy_invertida_aberta(PageTable* pt) {
+    OpenInvertedPageTable* impl = (OpenInvertedPageTable*)pt->impl;
+    free(impl->ctrl);
+    free(impl->slots);
+    free(impl->page_by_frame);
+    free(impl->frame_used);
+    free(impl);
+    free(pt);
+}
+
+size_t memory_cost_invertida_aberta(PageTable* pt) {
+    OpenInvertedPageTable* impl = (OpenInvertedPageTable*)pt->impl;
+    size_t cost = impl->capacity * (sizeof(uint8_t) + sizeof(IPTA_Slot));
+    cost += impl->num_frames * (sizeof(unsigned int) + sizeof(uint8_t));
+    return cost;
+}
+
+void print_stats_invertida_aberta(PageTable* pt, FILE* out) {
+    OpenInvertedPageTable* impl = (OpenInvertedPageTable*)pt->impl;
+    double lookups = impl->lookups ? (double)impl->lookups : 1.0;
+    fprintf(out, "  Capacidade da tabela hash: %zu posições (ocupação %.1f%%, %lu reconstruções)\n",
+            impl->capacity, 100.0 * (double)impl->size / (double)impl->capacity, impl->rehashes);
+    fprintf(out, "  Grupos sondados por consulta: %.3f (máximo %lu)\n",
+            (double)impl->groups_probed / lookups, impl->max_groups_probed);
+    fprintf(out, "  Chaves comparadas por consulta: %.3f\n", (double)impl->keys_compared / lookups);
+}
+
+PageTable* pagetable_invertida_aberta_create(int num_frames) {
+    PageTable* pt = calloc(1, sizeof(PageTable));
+    OpenInvertedPageTable* impl = calloc(1, sizeof(OpenInvertedPageTable));
+    pt->impl = impl;
+    pt->lookup = lookup_invertida_aberta;
+    pt->update = update_invertida_aberta;
+    pt->destroy = destroy_invertida_aberta;
+    pt->memory_cost = memory_cost_invertida_aberta;
+    pt->print_stats = print_stats_invertida_aberta;
+
+    // Menor potência de 2 que mantém todos os quadros abaixo do fator de carga máximo
+    size_t capacity = IPTA_GROUP_SIZE;
+    while ((size_t)num_frames * IPTA_MAX_LOAD_DEN > capacity * IPTA_MAX_LOAD_NUM) {
+        capacity *= 2;
+    }
+    ipta_alloc(impl, capacity);
+
+    impl->num_frames = num_frames;
+    impl->page_by_frame = malloc(num_frames * sizeof(unsigned int));
+    impl->frame_used = calloc(num_frames, sizeof(uint8_t));
+    return pt;
+}
+
+
+// --- SELEÇÃO POR NOME ---
+
+PageTable* pagetable_create_by_name(const char* name, int page_shift, int num_frames) {
+    if (strcmp(name, "densa") == 0) return pagetable_densa_create(page_shift);
+    if (strcmp(name, "densa_virtual") == 0) return pagetable_densa_virtual_create(page_shift);
+    // PWC_ENTRIES ativa o cache de caminhada das tabelas hierárquicas
+    int pwc_entries = getenv("PWC_ENTRIES") ? atoi(getenv("PWC_ENTRIES")) : 0;
+    if (strcmp(name, "hierarquica2") == 0) return pagetable_hierarquica_pwc_create(2, page_shift, pwc_entries);
+    if (strcmp(name, "hierarquica3") == 0) return pagetable_hierarquica_pwc_create(3, page_shift, pwc_entries);
+    if (strcmp(name, "densa_compacta") == 0) return pagetable_densa_compacta_create(page_shift, num_frames);
+    if (strcmp(name, "hierarquica2_compacta") == 0) return pagetable_hierarquica_compacta_create(2, page_shift, num_frames);
+    if (strcmp(name, "hierarquica3_compacta") == 0) return pagetable_hierarquica_compacta_create(3, page_shift, num_frames);
+    if (strcmp(name, "invertida") == 0) return pagetable_invertida_create(num_frames);
+    if (strcmp(name, "invertida_aberta") == 0) return pagetable_invertida_aberta_create(num_frames);
+    return NULL;
 }
\ No newline at end of file
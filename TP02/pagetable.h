@@ -1,6 +1,7 @@
 #ifndef PAGETABLE_H
 #define PAGETABLE_H
 
+#include <stdio.h>
 #include <stdlib.h>
 
 // Estrutura genérica para uma Tabela de Páginas
@@ -21,11 +22,28 @@ typedef struct PageTable {
     // Retorna o custo de memória da tabela em bytes
     size_t (*memory_cost)(struct PageTable* pt);
 
+    // Imprime estatísticas específicas da implementação no relatório. Pode ser NULL
+    void (*print_stats)(struct PageTable* pt, FILE* out);
+
+#ifdef INSTRUMENTACAO
+    // Comprimento das sondagens das tabelas com hash (ver instrumentacao.h). Pode ser NULL
+    struct Histograma* sondagens;
+#endif
 } PageTable;
 
 // Funções "construtoras" para cada tipo de tabela de páginas
 PageTable* pagetable_densa_create(int page_shift);
+PageTable* pagetable_densa_virtual_create(int page_shift); // só ocupa memória nas regiões tocadas
 PageTable* pagetable_hierarquica_create(int levels, int page_shift);
+// Tabela hierárquica com cache de caminhada de 'pwc_entries' posições por nível intermediário
+PageTable* pagetable_hierarquica_pwc_create(int levels, int page_shift, int pwc_entries);
 PageTable* pagetable_invertida_create(int num_frames);
+// Entradas de 16 ou 32 bits (quadro + 1, 0 = inválida), conforme o número de quadros
+PageTable* pagetable_densa_compacta_create(int page_shift, int num_frames);
+PageTable* pagetable_hierarquica_compacta_create(int levels, int page_shift, int num_frames);
+PageTable* pagetable_invertida_aberta_create(int num_frames);
+
+// Cria a tabela pelo nome usado em PAGE_TABLE_TYPE. Retorna NULL se o nome for desconhecido
+PageTable* pagetable_create_by_name(const char* name, int page_shift, int num_frames);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "paginas_grandes.h"
+#include "configuracao.h"
+#include "tlb.h"
+
+#define REGIAO_PROMOVIDA 1
+#define REGIAO_UM_RESIDENTE 2
+
+int paginas_grandes_do_ambiente(PaginasGrandes** g, const char* tabela, int tam_pagina_kb,
+                                int num_quadros, unsigned long long semente) {
+    *g = NULL;
+    const char* variavel = getenv("HUGE_PAGE_KB");
+    if (variavel == NULL || atoi(variavel) == 0) return 1;
+
+    int tam_grande_kb = atoi(variavel);
+    if (tam_grande_kb <= tam_pagina_kb || tam_grande_kb % tam_pagina_kb != 0 ||
+        ((tam_grande_kb / tam_pagina_kb) & (tam_grande_kb / tam_pagina_kb - 1)) != 0) {
+        fprintf(stderr, "Erro: HUGE_PAGE_KB=%d deve ser maior que a página base (%d KB) e múltiplo dela por uma potência de 2.\n",
+                tam_grande_kb, tam_pagina_kb);
+        return 0;
+    }
+    unsigned int paginas_por_regiao = (unsigned int)(tam_grande_kb / tam_pagina_kb);
+    if ((unsigned int)num_quadros < paginas_por_regiao) {
+        fprintf(stderr, "Aviso: memória menor que uma página grande de %d KB; páginas grandes desativadas.\n", tam_grande_kb);
+        return 1;
+    }
+
+    unsigned int limiar = paginas_por_regiao / 2;
+    if (getenv("HUGE_PROMOTE")) limiar = (unsigned int)atoi(getenv("HUGE_PROMOTE"));
+    if (limiar < 1 || limiar > paginas_por_regiao) {
+        fprintf(stderr, "Erro: HUGE_PROMOTE deve estar entre 1 e %u páginas base.\n", paginas_por_regiao);
+        return 0;
+    }
+
+    PageTable* pt = pagetable_create_by_name(tabela, calcular_deslocamento(tam_grande_kb), num_quadros);
+    if (pt == NULL) return 0;
+    if (!pagetable_tlb_do_ambiente(&pt, semente)) {
+        pt->destroy(pt);
+        return 0;
+    }
+
+    PaginasGrandes* grandes = calloc(1, sizeof(PaginasGrandes));
+    grandes->pt = pt;
+    grandes->deslocamento = calcular_deslocamento(tam_grande_kb) - calcular_deslocamento(tam_pagina_kb);
+    grandes->paginas_por_regiao = paginas_por_regiao;
+    grandes->limiar = limiar;
+    grandes->tam_pagina_kb = tam_grande_kb;
+    grandes->regioes = mapa_paginas_criar((size_t)num_quadros / paginas_por_regiao + 16);
+    grandes->quadros = mapa_paginas_criar((size_t)num_quadros);
+    *g = grandes;
+    return 1;
+}
+
+static int estado_regiao(PaginasGrandes* g, unsigned int regiao) {
+    int estado;
+    return mapa_paginas_buscar(g->regioes, regiao, &estado) ? estado : 0;
+}
+
+static void definir_estado_regiao(PaginasGrandes* g, unsigned int regiao, int estado) {
+    if (estado == 0) mapa_paginas_remover(g->regioes, regiao);
+    else mapa_paginas_inserir(g->regioes, regiao, estado);
+}
+
+int paginas_grandes_consultar(PaginasGrandes* g, unsigned int pagina, int* custo) {
+    int custo_grande = 0;
+    *custo = 0;
+    if (g->pt->lookup(g->pt, pagina >> g->deslocamento, &custo_grande) == -1) return -1;
+
+    int quadro;
+    mapa_paginas_buscar(g->quadros, pagina, &quadro);
+    g->acessos++;
+    g->custo_consulta += custo_grande;
+    *custo = custo_grande;
+    return quadro;
+}
+
+int paginas_grandes_residente(PaginasGrandes* g, unsigned int pagina) {
+    int quadro;
+    return mapa_paginas_buscar(g->quadros, pagina, &quadro);
+}
+
+int paginas_grandes_carregada(PaginasGrandes* g, unsigned int pagina, int quadro) {
+    unsigned int regiao = pagina >> g->deslocamento;
+    int estado = estado_regiao(g, regiao) + REGIAO_UM_RESIDENTE;
+    mapa_paginas_inserir(g->quadros, pagina, quadro);
+    definir_estado_regiao(g, regiao, estado);
+    return !(estado & REGIAO_PROMOVIDA) && (unsigned int)(estado / REGIAO_UM_RESIDENTE) >= g->limiar;
+}
+
+void paginas_grandes_removida(PaginasGrandes* g, unsigned int pagina) {
+    unsigned int regiao = pagina >> g->deslocamento;
+    int estado = estado_regiao(g, regiao) - REGIAO_UM_RESIDENTE;
+    mapa_paginas_remover(g->quadros, pagina);
+    if (estado & REGIAO_PROMOVIDA) {
+        g->pt->update(g->pt, regiao, -1);
+        estado &= ~REGIAO_PROMOVIDA;
+        g->rebaixamentos++;
+        g->regioes_promovidas--;
+    }
+    definir_estado_regiao(g, regiao, estado);
+}
+
+void paginas_grandes_promover(PaginasGrandes* g, unsigned int regiao) {
+    int estado = estado_regiao(g, regiao);
+    if ((unsigned int)(estado / REGIAO_UM_RESIDENTE) < g->paginas_por_regiao) {
+        // Alguma página da região foi substituída durante a própria promoção
+        g->promocoes_interrompidas++;
+        return;
+    }
+    int quadro;
+    mapa_paginas_buscar(g->quadros, regiao << g->deslocamento, &quadro);
+    g->pt->update(g->pt, regiao, quadro);
+    definir_estado_regiao(g, regiao, estado | REGIAO_PROMOVIDA);
+    g->promocoes++;
+    if (++g->regioes_promovidas > g->max_regioes_promovidas) g->max_regioes_promovidas = g->regioes_promovidas;
+}
+
+static double media(unsigned long total, unsigned long n) {
+    return n > 0 ? (double)total / (double)n : 0.0;
+}
+
+void paginas_grandes_imprimir(PaginasGrandes* g, FILE* out, unsigned long acessos_base,
+                              unsigned int faltas, unsigned long custo_base) {
+    fprintf(out, "\nPáginas Grandes (%d KB, %u páginas base; promoção com %u residentes):\n",
+            g->tam_pagina_kb, g->paginas_por_regiao, g->limiar);
+    fprintf(out, "  Promoções: %lu (interrompidas: %lu), rebaixamentos: %lu\n",
+            g->promocoes, g->promocoes_interrompidas, g->rebaixamentos);
+    fprintf(out, "  Regiões promovidas no fim: %u (máximo: %u)\n", g->regioes_promovidas, g->max_regioes_promovidas);
+    fprintf(out, "  Páginas lidas nas promoções: %lu\n", g->paginas_lidas_promocao);
+    fprintf(out, "  Páginas base: %lu acessos, %u page faults, custo médio de consulta %.2f\n",
+            acessos_base, faltas, media(custo_base, acessos_base));
+    fprintf(out, "  Páginas grandes: %lu acessos, custo médio de consulta %.2f\n",
+            g->acessos, media(g->custo_consulta, g->acessos));
+    fprintf(out, "  Custo de memória da tabela grande: %.2f KB\n", (double)g->pt->memory_cost(g->pt) / 1024.0);
+    if (g->pt->print_stats) g->pt->print_stats(g->pt, out);
+}
+
+void paginas_grandes_destruir(PaginasGrandes* g) {
+    if (g == NULL) return;
+    g->pt->destroy(g->pt);
+    mapa_paginas_destruir(g->regioes);
+    mapa_paginas_destruir(g->quadros);
+    free(g);
+}
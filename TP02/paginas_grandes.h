@@ -0,0 +1,70 @@
+#ifndef PAGINAS_GRANDES_H
+#define PAGINAS_GRANDES_H
+
+#include <stdio.h>
+#include "pagetable.h"
+#include "mapa_paginas.h"
+
+// Segundo tamanho de página (página grande, ex: 2 MB sobre páginas de 4 KB).
+// A memória continua dividida em quadros do tamanho base: uma página grande é
+// uma região alinhada cujas páginas base estão todas residentes. Quando uma
+// região atinge o limiar de páginas residentes, as que faltam são carregadas e
+// a região passa a ser traduzida por uma segunda tabela, no tamanho grande
+// (promoção). Se qualquer página da região for substituída, a tradução grande
+// é desfeita (rebaixamento) e as páginas restantes voltam a ser traduzidas
+// pela tabela base, que mantém seus mapeamentos durante todo o tempo
+
+typedef struct {
+    PageTable* pt;                  // região -> quadro da primeira página da região
+    int deslocamento;               // log2 do número de páginas base por região
+    unsigned int paginas_por_regiao;
+    unsigned int limiar;            // páginas residentes para promover a região
+    int tam_pagina_kb;
+
+    MapaPaginas* regioes;           // região -> residentes * 2 + (1 se promovida)
+    MapaPaginas* quadros;           // página base residente -> quadro
+
+    // Estatísticas
+    unsigned long acessos;          // acessos traduzidos pela tabela grande
+    unsigned long custo_consulta;
+    unsigned long promocoes;
+    unsigned long promocoes_interrompidas;
+    unsigned long rebaixamentos;
+    unsigned long paginas_lidas_promocao;
+    unsigned int regioes_promovidas;
+    unsigned int max_regioes_promovidas;
+} PaginasGrandes;
+
+// Cria as páginas grandes se HUGE_PAGE_KB estiver definida (HUGE_PROMOTE:
+// páginas base residentes para promover uma região, padrão metade dela).
+// A tabela grande é do mesmo tipo da base e recebe a mesma TLB, se houver
+// (TLBs separadas por tamanho, como nos processadores). *g fica NULL se as
+// páginas grandes não forem usadas. Retorna 0 (com mensagem de erro) se a
+// configuração for inválida
+int paginas_grandes_do_ambiente(PaginasGrandes** g, const char* tabela, int tam_pagina_kb,
+                                int num_quadros, unsigned long long semente);
+
+// Traduz a página pela tabela grande. Retorna o quadro da página base, ou -1
+// se a região não estiver promovida. Só acertos entram no custo de consulta:
+// na caminhada real, a falta é a própria entrada intermediária da tabela base
+int paginas_grandes_consultar(PaginasGrandes* g, unsigned int pagina, int* custo);
+
+int paginas_grandes_residente(PaginasGrandes* g, unsigned int pagina);
+
+// Registra a carga da página no quadro. Retorna 1 se a região da página
+// atingiu o limiar de promoção e ainda não foi promovida
+int paginas_grandes_carregada(PaginasGrandes* g, unsigned int pagina, int quadro);
+
+// Registra a substituição da página, rebaixando a região se estiver promovida
+void paginas_grandes_removida(PaginasGrandes* g, unsigned int pagina);
+
+// Promove a região, se todas as suas páginas estiverem residentes
+void paginas_grandes_promover(PaginasGrandes* g, unsigned int regiao);
+
+// Relatório por tamanho de página. 'acessos_base', 'faltas' (sem as cargas das promoções) e 'custo_base' vêm da simulação
+void paginas_grandes_imprimir(PaginasGrandes* g, FILE* out, unsigned long acessos_base,
+                              unsigned int faltas, unsigned long custo_base);
+
+void paginas_grandes_destruir(PaginasGrandes* g);
+
+#endif
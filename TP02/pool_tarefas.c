@@ -0,0 +1,145 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "pool_tarefas.h"
+#include "configuracao.h"
+
+typedef struct {
+    pthread_mutex_t trava;
+    int* tarefas;
+    int inicio; // próxima tarefa a ser roubada
+    int fim;    // uma posição após a próxima tarefa da dona
+} FilaTarefas;
+
+typedef struct {
+    FilaTarefas* filas;
+    int num_threads;
+    FuncaoTarefa funcao;
+    void* contexto;
+    pthread_mutex_t trava_roubos;
+    unsigned long roubos;
+} Pool;
+
+typedef struct {
+    Pool* pool;
+    int indice;
+} ArgumentoThread;
+
+static int retirar_propria(FilaTarefas* fila, int* tarefa) {
+    int ok = 0;
+    pthread_mutex_lock(&fila->trava);
+    if (fila->fim > fila->inicio) {
+        *tarefa = fila->tarefas[--fila->fim];
+        ok = 1;
+    }
+    pthread_mutex_unlock(&fila->trava);
+    return ok;
+}
+
+static int roubar(FilaTarefas* fila, int* tarefa) {
+    int ok = 0;
+    pthread_mutex_lock(&fila->trava);
+    if (fila->fim > fila->inicio) {
+        *tarefa = fila->tarefas[fila->inicio++];
+        ok = 1;
+    }
+    pthread_mutex_unlock(&fila->trava);
+    return ok;
+}
+
+static void* trabalhar(void* arg) {
+    ArgumentoThread* a = (ArgumentoThread*)arg;
+    Pool* pool = a->pool;
+    int tarefa;
+    unsigned long roubos = 0;
+
+    for (;;) {
+        if (retirar_propria(&pool->filas[a->indice], &tarefa)) {
+            pool->funcao(pool->contexto, tarefa);
+            continue;
+        }
+
+        // Fila própria vazia: tenta roubar das outras, começando pela vizinha
+        int roubou = 0;
+        for (int k = 1; k < pool->num_threads && !roubou; k++) {
+            int vitima = (a->indice + k) % pool->num_threads;
+            roubou = roubar(&pool->filas[vitima], &tarefa);
+        }
+        if (!roubou) break;
+        roubos++;
+        pool->funcao(pool->contexto, tarefa);
+    }
+
+    pthread_mutex_lock(&pool->trava_roubos);
+    pool->roubos += roubos;
+    pthread_mutex_unlock(&pool->trava_roubos);
+    return NULL;
+}
+
+int pool_threads_padrao(void) {
+    const char* variavel = getenv("SIM_THREADS");
+    if (variavel != NULL && atoi(variavel) > 0) return atoi(variavel);
+    long processadores = sysconf(_SC_NPROCESSORS_ONLN);
+    return processadores > 0 ? (int)processadores : 1;
+}
+
+void pool_executar(int num_threads, int num_tarefas, FuncaoTarefa funcao, void* contexto,
+                   EstatisticasPool* estatisticas) {
+    double inicio = tempo_em_segundos();
+    if (num_threads < 1) num_threads = 1;
+    if (num_threads > num_tarefas) num_threads = num_tarefas > 0 ? num_tarefas : 1;
+
+    Pool pool;
+    pool.num_threads = num_threads;
+    pool.funcao = funcao;
+    pool.contexto = contexto;
+    pool.roubos = 0;
+    pthread_mutex_init(&pool.trava_roubos, NULL);
+    pool.filas = malloc(num_threads * sizeof(FilaTarefas));
+
+    // Distribuição inicial em blocos contíguos; a dona executa do fim para o início
+    for (int t = 0; t < num_threads; t++) {
+        FilaTarefas* fila = &pool.filas[t];
+        int primeira = (int)((long)num_tarefas * t / num_threads);
+        int ultima = (int)((long)num_tarefas * (t + 1) / num_threads);
+        pthread_mutex_init(&fila->trava, NULL);
+        fila->tarefas = malloc((ultima - primeira + 1) * sizeof(int));
+        fila->inicio = 0;
+        fila->fim = 0;
+        for (int i = ultima - 1; i >= primeira; i--) fila->tarefas[fila->fim++] = i;
+    }
+
+    pthread_t* threads = malloc(num_threads * sizeof(pthread_t));
+    ArgumentoThread* argumentos = malloc(num_threads * sizeof(ArgumentoThread));
+    for (int t = 0; t < num_threads; t++) {
+        argumentos[t].pool = &pool;
+        argumentos[t].indice = t;
+    }
+    // A thread principal também trabalha, como a thread 0. Se uma thread não puder ser
+    // criada, as tarefas da sua fila são roubadas pelas demais
+    int lancadas = 0;
+    for (int t = 1; t < num_threads; t++) {
+        if (pthread_create(&threads[lancadas], NULL, trabalhar, &argumentos[t]) == 0) lancadas++;
+    }
+    trabalhar(&argumentos[0]);
+    for (int i = 0; i < lancadas; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    for (int t = 0; t < num_threads; t++) {
+        pthread_mutex_destroy(&pool.filas[t].trava);
+        free(pool.filas[t].tarefas);
+    }
+    pthread_mutex_destroy(&pool.trava_roubos);
+    free(pool.filas);
+    free(threads);
+    free(argumentos);
+
+    if (estatisticas) {
+        estatisticas->num_threads = num_threads;
+        estatisticas->roubos = pool.roubos;
+        estatisticas->tempo_total = tempo_em_segundos() - inicio;
+    }
+}
@@ -0,0 +1,25 @@
+#ifndef POOL_TAREFAS_H
+#define POOL_TAREFAS_H
+
+// Pool de threads com roubo de tarefas (work stealing) para executar um
+// conjunto fixo de tarefas independentes, identificadas por 0..num_tarefas-1.
+// Cada thread tem sua própria fila: retira tarefas do fim da sua fila e, quando
+// ela esvazia, rouba do início da fila de outra thread. Como as tarefas não
+// criam novas tarefas, a execução termina quando todas as filas esvaziam
+
+typedef void (*FuncaoTarefa)(void* contexto, int tarefa);
+
+typedef struct {
+    int num_threads;
+    double tempo_total;          // segundos
+    unsigned long roubos;        // tarefas executadas por uma thread diferente da dona
+} EstatisticasPool;
+
+// Número de threads padrão: variável de ambiente SIM_THREADS ou o número de processadores
+int pool_threads_padrao(void);
+
+// Executa todas as tarefas e só retorna quando todas terminarem
+void pool_executar(int num_threads, int num_tarefas, FuncaoTarefa funcao, void* contexto,
+                   EstatisticasPool* estatisticas);
+
+#endif
@@ -1,3 +1,5 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -5,123 +7,378 @@
 #include "memoria.h"
 #include "algoritmos.h"
 #include "pagetable.h"
+#include "leitor_trace.h"
+#include "mrc.h"
+#include "configuracao.h"
+#include "lote.h"
+#include "decodificador_paralelo.h"
 
-// Variável global definida em memoria.c
-extern unsigned long total_lookup_cost;
+// Acessos lidos do trace por vez antes de serem entregues à simulação
+#define TAM_LOTE 4096
 
-int calcular_deslocamento(int tam_pagina_kb) {
-    int tmp = tam_pagina_kb * 1024;
-    int s = 0;
-    while (tmp > 1) {
-        tmp = tmp >> 1;
-        s++;
+static void imprimir_leitura(const char* modo_leitura, double tempo_leitura, size_t bytes_lidos, unsigned long total_acessos,
+                             DecodificadorParalelo* decodificador) {
+    printf("Leitura do Trace:\n");
+    if (decodificador) {
+        printf("  Modo de leitura: %s, decodificação paralela (%d threads)\n", modo_leitura, decodificador->num_threads);
+        tempo_leitura = decodificador->tempo_decodificacao;
+    } else {
+        printf("  Modo de leitura: %s\n", modo_leitura);
+    }
+    printf("  Tempo de interpretação: %.3f s\n", tempo_leitura);
+    if (tempo_leitura > 0.0) {
+        if (bytes_lidos > 0) {
+            printf("  Vazão de interpretação: %.2f MB/s\n", (double)bytes_lidos / (1024.0 * 1024.0) / tempo_leitura);
+        }
+        printf("  Acessos interpretados por segundo: %.2f milhões\n", (double)total_acessos / 1e6 / tempo_leitura);
+    }
+    if (decodificador) {
+        printf("  Tempo de espera da simulação pela decodificação: %.3f s\n", decodificador->tempo_espera);
     }
-    return s;
 }
 
-int main(int argc, char *argv[]) {
-    // A validação de argumentos volta para o formato original
-    if (argc < 5 || argc > 6) {
-        fprintf(stderr, "Uso: %s <alg_subst> <arquivo.log> <tam_pag_kb> <tam_mem_kb> [debug]\n", argv[0]);
-        fprintf(stderr, "  alg_subst: lru, lfu, fifo, random\n");
-        fprintf(stderr, "  Para selecionar a tabela de páginas, defina a variável de ambiente PAGE_TABLE_TYPE.\n");
-        fprintf(stderr, "  Ex: PAGE_TABLE_TYPE=invertida %s lru ...\n", argv[0]);
+// Entrega um lote de acessos empacotados a todas as configurações. Os acessos
+// foram decodificados com o menor deslocamento entre elas
+static void simular_empacotados(Configuracao* configs, int num_configs, int deslocamento_base,
+                                const uint32_t* acessos, size_t n) {
+    for (int c = 0; c < num_configs; c++) {
+        Simulacao* sim = configs[c].sim;
+        int deslocamento = configs[c].deslocamento_s - deslocamento_base;
+        for (size_t i = 0; i < n; i++) {
+            simulacao_acessar(sim, ACESSO_PAGINA(acessos[i]) >> deslocamento, ACESSO_TIPO(acessos[i]));
+        }
+    }
+}
+
+// Carrega o trace inteiro se alguma configuração precisar dele (ver
+// configuracao_precisa_trace). Retorna 0 se o arquivo não puder ser lido
+static int carregar_trace_se_preciso(const char* nome_arquivo, Configuracao* configs, int num_configs,
+                                     TraceCarregado** trace, double* tempo_carga) {
+    *trace = NULL;
+    *tempo_carga = 0.0;
+    int preciso = 0;
+    for (int c = 0; c < num_configs; c++) preciso |= configuracao_precisa_trace(configs[c].algoritmo);
+    if (!preciso) return 1;
+
+    double t0 = tempo_em_segundos();
+    *trace = trace_carregar(nome_arquivo);
+    *tempo_carga = tempo_em_segundos() - t0;
+    if (*trace == NULL) {
+        perror("Erro ao abrir o arquivo de log");
+        return 0;
+    }
+    for (int c = 0; c < num_configs; c++) configs[c].trace = *trace;
+    return 1;
+}
+
+// Lê o trace uma única vez, entregando cada lote de acessos a todas as configurações.
+// Se o trace já estiver carregado (configs[].trace), simula a partir da memória.
+// Retorna 0 se o arquivo não puder ser aberto
+static int executar_trace(const char* nome_arquivo, Configuracao* configs, int num_configs, double tempo_carga) {
+    const TraceCarregado* trace = configs[0].trace;
+    if (trace) {
+        printf("Executando o simulador...\n");
+        for (int c = 0; c < num_configs; c++) configuracao_simular_trace(&configs[c]);
+        for (int c = 0; c < num_configs; c++) {
+            if (num_configs > 1) {
+                printf("\n>>> Teste: Log=%s, Alg=%s, Mem=%dKB, Pag=%dKB, Tabela=%s",
+                       nome_arquivo, configs[c].algoritmo, configs[c].tam_memoria_kb,
+                       configs[c].tam_pagina_kb, configs[c].tabela);
+            }
+            imprimir_relatorio(stdout, nome_arquivo, &configs[c]);
+            if (num_configs == 1) imprimir_leitura("carregado em memória", tempo_carga, 0, trace->num_acessos, NULL);
+            printf("-----------------------\n");
+        }
+        if (num_configs > 1) {
+            printf("\nVarredura: %d configurações simuladas a partir do trace carregado em memória.\n", num_configs);
+            imprimir_leitura("carregado em memória", tempo_carga, 0, trace->num_acessos, NULL);
+        }
         return 1;
     }
-    
-    char* nome_algoritmo_subst = argv[1];
-    char* nome_arquivo = argv[2];
-    int tam_pagina_kb = atoi(argv[3]);
-    int tam_memoria_kb = atoi(argv[4]);
 
-    if (argc == 6 && strcmp(argv[5], "debug") == 0) {
-        debug_mode = 1;
+    LeitorTrace* leitor = leitor_trace_abrir(nome_arquivo);
+    if (!leitor) {
+        perror("Erro ao abrir o arquivo de log");
+        return 0;
+    }
+
+    printf("Executando o simulador...\n");
+    unsigned long total_acessos = 0;
+    double tempo_leitura = 0.0;
+    size_t lidos;
+
+    int deslocamento_base = configs[0].deslocamento_s;
+    for (int c = 1; c < num_configs; c++) {
+        if (configs[c].deslocamento_s < deslocamento_base) deslocamento_base = configs[c].deslocamento_s;
     }
+    DecodificadorParalelo* decodificador =
+        decodificador_paralelo_criar(leitor, deslocamento_base, decodificador_threads_padrao());
 
-    // --- Seleção do Algoritmo de Substituição ---
-    int (*algoritmo_selecionado)(Frame*, int);
-    if (strcmp(nome_algoritmo_subst, "lru") == 0) algoritmo_selecionado = encontrar_vitima_lru;
-    else if (strcmp(nome_algoritmo_subst, "lfu") == 0) algoritmo_selecionado = encontrar_vitima_lfu;
-    else if (strcmp(nome_algoritmo_subst, "fifo") == 0) algoritmo_selecionado = encontrar_vitima_fifo;
-    else if (strcmp(nome_algoritmo_subst, "random") == 0) {
-        srandom(time(NULL));
-        algoritmo_selecionado = encontrar_vitima_random;
+    if (decodificador) {
+        const uint32_t* acessos;
+        while ((lidos = decodificador_paralelo_proximo(decodificador, &acessos)) > 0) {
+            simular_empacotados(configs, num_configs, deslocamento_base, acessos, lidos);
+            total_acessos += lidos;
+        }
     } else {
-        fprintf(stderr, "Erro: Algoritmo de substituição '%s' desconhecido.\n", nome_algoritmo_subst);
+        unsigned int enderecos[TAM_LOTE];
+        char tipos[TAM_LOTE];
+
+        // O trace é lido em lotes para que o tempo de interpretação possa ser
+        // medido separadamente do tempo de simulação
+        do {
+            double t0 = tempo_em_segundos();
+            lidos = leitor_trace_lote(leitor, enderecos, tipos, TAM_LOTE);
+            tempo_leitura += tempo_em_segundos() - t0;
+
+            for (int c = 0; c < num_configs; c++) {
+                Simulacao* sim = configs[c].sim;
+                int deslocamento_s = configs[c].deslocamento_s;
+                for (size_t i = 0; i < lidos; i++) {
+                    unsigned int numero_pagina = enderecos[i] >> deslocamento_s;
+                    simulacao_acessar(sim, numero_pagina, tipos[i]);
+                }
+            }
+            total_acessos += lidos;
+        } while (lidos == TAM_LOTE);
+    }
+
+    size_t bytes_lidos = leitor_trace_bytes_lidos(leitor);
+    const char* modo_leitura = leitor_trace_nome_modo(leitor);
+
+    // --- Relatório Final ---
+    for (int c = 0; c < num_configs; c++) {
+        if (num_configs > 1) {
+            printf("\n>>> Teste: Log=%s, Alg=%s, Mem=%dKB, Pag=%dKB, Tabela=%s",
+                   nome_arquivo, configs[c].algoritmo, configs[c].tam_memoria_kb,
+                   configs[c].tam_pagina_kb, configs[c].tabela);
+        }
+        imprimir_relatorio(stdout, nome_arquivo, &configs[c]);
+        if (num_configs == 1) imprimir_leitura(modo_leitura, tempo_leitura, bytes_lidos, total_acessos, decodificador);
+        printf("-----------------------\n");
+    }
+    if (num_configs > 1) {
+        printf("\nVarredura: %d configurações simuladas em uma única leitura do trace.\n", num_configs);
+        imprimir_leitura(modo_leitura, tempo_leitura, bytes_lidos, total_acessos, decodificador);
+    }
+    decodificador_paralelo_destruir(decodificador);
+    leitor_trace_fechar(leitor);
+    return 1;
+}
+
+// Separa uma lista "a,b,c" (modificando a string). Retorna o número de itens,
+// ou -1 (com mensagem de erro) se a lista tiver mais de max_itens
+static int separar_lista(char* lista, char** itens, int max_itens, const char* descricao) {
+    int n = 0;
+    for (char* item = strtok(lista, ","); item; item = strtok(NULL, ",")) {
+        if (n == max_itens) {
+            fprintf(stderr, "Erro: a lista de %s tem mais de %d itens.\n", descricao, max_itens);
+            return -1;
+        }
+        itens[n++] = item;
+    }
+    return n;
+}
+
+#define MAX_ITENS_LISTA 32
+
+// Modo varredura: todas as combinações de algoritmos, tamanhos e tabelas em uma passada
+static int executar_varredura(int argc, char *argv[]) {
+    if (argc < 6 || argc > 7) {
+        fprintf(stderr, "Uso: %s varredura <arquivo.log> <algs> <tam_pags_kb> <tam_mems_kb> [tabelas]\n", argv[0]);
+        fprintf(stderr, "  Listas separadas por vírgula. Ex: %s varredura compressor.log lru,fifo 4,8 128,256,512\n", argv[0]);
+        fprintf(stderr, "  Sem [tabelas], usa PAGE_TABLE_TYPE (ou hierarquica2).\n");
         return 1;
     }
-    
-    // --- Cálculos de Parâmetros ---
-    int deslocamento_s = calcular_deslocamento(tam_pagina_kb);
-    int num_quadros = (tam_memoria_kb * 1024) / (tam_pagina_kb * 1024);
 
-    // --- Criação da Tabela de Páginas via Variável de Ambiente ---
-    PageTable* pt = NULL;
-    char* nome_tipo_tabela = getenv("PAGE_TABLE_TYPE");
+    char* algoritmos[MAX_ITENS_LISTA];
+    char* paginas[MAX_ITENS_LISTA];
+    char* memorias[MAX_ITENS_LISTA];
+    char* tabelas[MAX_ITENS_LISTA];
+    const char* tabelas_ambiente = getenv("PAGE_TABLE_TYPE");
+    const char* origem_tabelas = argc == 7 ? "argumento [tabelas]" : tabelas_ambiente ? "PAGE_TABLE_TYPE" : NULL;
+    // Cópia: strtok modifica a lista, e a string de getenv não pode ser alterada
+    char* lista_tabelas = strdup(argc == 7 ? argv[6] : tabelas_ambiente ? tabelas_ambiente : "hierarquica2");
 
-    // Se a variável não estiver definida, usa um padrão e avisa o usuário.
-    if (nome_tipo_tabela == NULL) {
-        printf("Aviso: Variável de ambiente PAGE_TABLE_TYPE não definida. Usando 'hierarquica2' como padrão.\n");
-        nome_tipo_tabela = "hierarquica2";
+    int n_alg = separar_lista(argv[3], algoritmos, MAX_ITENS_LISTA, "algoritmos");
+    int n_pag = separar_lista(argv[4], paginas, MAX_ITENS_LISTA, "tamanhos de página");
+    int n_mem = separar_lista(argv[5], memorias, MAX_ITENS_LISTA, "tamanhos de memória");
+    int n_tab = separar_lista(lista_tabelas, tabelas, MAX_ITENS_LISTA, "tabelas");
+    if (n_alg < 0 || n_pag < 0 || n_mem < 0 || n_tab < 0) {
+        free(lista_tabelas);
+        return 1;
     }
 
-    if (strcmp(nome_tipo_tabela, "densa") == 0) {
-        pt = pagetable_densa_create(deslocamento_s);
-    } else if (strcmp(nome_tipo_tabela, "hierarquica2") == 0) {
-        pt = pagetable_hierarquica_create(2, deslocamento_s);
-    } else if (strcmp(nome_tipo_tabela, "hierarquica3") == 0) {
-        pt = pagetable_hierarquica_create(3, deslocamento_s);
-    } else if (strcmp(nome_tipo_tabela, "invertida") == 0) {
-        pt = pagetable_invertida_create(num_quadros);
-    } else {
-        fprintf(stderr, "Erro: Tipo de tabela de páginas '%s' (de PAGE_TABLE_TYPE) desconhecido.\n", nome_tipo_tabela);
+    int num_configs = n_alg * n_pag * n_mem * n_tab;
+    Configuracao* configs = calloc(num_configs > 0 ? num_configs : 1, sizeof(Configuracao));
+    unsigned long long semente = (unsigned long long)time(NULL);
+    int c = 0;
+    for (int t = 0; t < n_tab; t++) {
+        for (int a = 0; a < n_alg; a++) {
+            for (int p = 0; p < n_pag; p++) {
+                for (int m = 0; m < n_mem; m++) {
+                    Configuracao* cfg = &configs[c++];
+                    cfg->algoritmo = algoritmos[a];
+                    cfg->tabela = tabelas[t];
+                    cfg->origem_tabela = origem_tabelas;
+                    cfg->tam_pagina_kb = atoi(paginas[p]);
+                    cfg->tam_memoria_kb = atoi(memorias[m]);
+                }
+            }
+        }
+    }
+
+    // A política opt precisa do trace antes de ser criada
+    TraceCarregado* trace = NULL;
+    double tempo_carga = 0.0;
+    int ok = num_configs > 0 && carregar_trace_se_preciso(argv[2], configs, num_configs, &trace, &tempo_carga);
+    for (c = 0; c < num_configs && ok; c++) {
+        ok = criar_configuracao(&configs[c], semente + (unsigned long long)c);
+    }
+
+    if (ok) ok = executar_trace(argv[2], configs, num_configs, tempo_carga);
+
+    for (int i = 0; i < num_configs; i++) configuracao_destruir(&configs[i]);
+    trace_liberar(trace);
+    free(configs);
+    free(lista_tabelas);
+    return ok ? 0 : 1;
+}
+
+// Modo mrc: curva exata de faltas do LRU para todos os tamanhos de memória em uma passada
+static int executar_mrc(int argc, char *argv[]) {
+    if (argc < 4 || argc > 5) {
+        fprintf(stderr, "Uso: %s mrc <arquivo.log> <tam_pag_kb> [tam_max_mem_kb]\n", argv[0]);
         return 1;
     }
+    const char* nome_arquivo = argv[2];
+    int tam_pagina_kb = atoi(argv[3]);
+    int tam_max_memoria_kb = argc == 5 ? atoi(argv[4]) : 0;
+    if (tam_pagina_kb <= 0) {
+        fprintf(stderr, "Erro: tamanho de página inválido (%d KB).\n", tam_pagina_kb);
+        return 1;
+    }
+    int deslocamento_s = calcular_deslocamento(tam_pagina_kb);
 
-    // --- Inicialização ---
-    // (O resto do código é idêntico ao anterior)
-    inicializar_memoria(num_quadros);
-    FILE* arquivo_log = fopen(nome_arquivo, "r");
-    if (!arquivo_log) {
+    LeitorTrace* leitor = leitor_trace_abrir(nome_arquivo);
+    if (!leitor) {
         perror("Erro ao abrir o arquivo de log");
-        pt->destroy(pt);
-        liberar_memoria();
         return 1;
     }
 
-    // --- Loop Principal ---
     printf("Executando o simulador...\n");
-    unsigned int addr;
-    char rw;
-    unsigned long total_acessos = 0;
-
-    while (fscanf(arquivo_log, "%x %c", &addr, &rw) == 2) {
-        total_acessos++;
-        unsigned int numero_pagina = addr >> deslocamento_s;
-        acessar_endereco(numero_pagina, rw, pt, num_quadros, algoritmo_selecionado);
+    CurvaLRU* curva = curva_lru_criar();
+    double tempo_leitura = 0.0;
+    size_t lidos;
+    DecodificadorParalelo* decodificador =
+        decodificador_paralelo_criar(leitor, deslocamento_s, decodificador_threads_padrao());
+    if (decodificador) {
+        const uint32_t* acessos;
+        while ((lidos = decodificador_paralelo_proximo(decodificador, &acessos)) > 0) {
+            for (size_t i = 0; i < lidos; i++) {
+                curva_lru_acessar(curva, ACESSO_PAGINA(acessos[i]), ACESSO_TIPO(acessos[i]));
+            }
+        }
+    } else {
+        unsigned int enderecos[TAM_LOTE];
+        char tipos[TAM_LOTE];
+        do {
+            double t0 = tempo_em_segundos();
+            lidos = leitor_trace_lote(leitor, enderecos, tipos, TAM_LOTE);
+            tempo_leitura += tempo_em_segundos() - t0;
+            for (size_t i = 0; i < lidos; i++) {
+                curva_lru_acessar(curva, enderecos[i] >> deslocamento_s, tipos[i]);
+            }
+        } while (lidos == TAM_LOTE);
     }
-    
-    fclose(arquivo_log);
 
-    // --- Relatório Final ---
-    printf("\n--- Relatório Final ---\n");
+    size_t bytes_lidos = leitor_trace_bytes_lidos(leitor);
+    const char* modo_leitura = leitor_trace_nome_modo(leitor);
+
+    printf("\n--- Curva de Faltas do LRU ---\n");
     printf("Configuração:\n");
     printf("  Arquivo de entrada: %s\n", nome_arquivo);
-    printf("  Tamanho da memória: %d KB\n", tam_memoria_kb);
     printf("  Tamanho das páginas: %d KB\n", tam_pagina_kb);
-    printf("  Algoritmo de substituição: %s\n", nome_algoritmo_subst);
-    printf("  Estrutura da Tabela de Páginas: %s (via PAGE_TABLE_TYPE)\n\n", nome_tipo_tabela);
-    printf("Resultados da Simulação:\n");
-    printf("  Total de acessos à memória: %lu\n", total_acessos);
-    printf("  Total de page faults (páginas lidas): %u\n", paginas_lidas);
-    printf("  Total de páginas escritas (dirty pages): %u\n\n", paginas_escritas);
-    printf("Análise da Tabela de Páginas:\n");
-    printf("  Custo de memória da tabela: %.2f KB\n", (double)pt->memory_cost(pt) / 1024.0);
-    printf("  Custo médio de consulta: %.2f acessos/operação\n", (double)total_lookup_cost / (double)total_acessos);
+    printf("  Total de acessos à memória: %lu\n", curva->total_acessos);
+    printf("  Páginas distintas (faltas compulsórias): %lu\n\n", curva->faltas_compulsorias);
+    curva_lru_imprimir(curva, stdout, tam_pagina_kb, (size_t)(tam_max_memoria_kb / tam_pagina_kb));
+    printf("\n");
+    imprimir_leitura(modo_leitura, tempo_leitura, bytes_lidos, curva->total_acessos, decodificador);
     printf("-----------------------\n");
 
-    // --- Limpeza ---
-    pt->destroy(pt);
-    liberar_memoria();
+    decodificador_paralelo_destruir(decodificador);
+    leitor_trace_fechar(leitor);
+    curva_lru_destruir(curva);
     return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc >= 2 && strcmp(argv[1], "varredura") == 0) {
+        return executar_varredura(argc, argv);
+    }
+    if (argc >= 2 && strcmp(argv[1], "mrc") == 0) {
+        return executar_mrc(argc, argv);
+    }
+    if (argc >= 2 && strcmp(argv[1], "lote") == 0) {
+        return executar_lote(argc, argv);
+    }
+
+    // A validação de argumentos volta para o formato original
+    if (argc < 5 || argc > 6) {
+        fprintf(stderr, "Uso: %s <alg_subst> <arquivo.log> <tam_pag_kb> <tam_mem_kb> [debug]\n", argv[0]);
+        fprintf(stderr, "  arquivo.log: log texto ou trace binário; \"-\" lê da entrada padrão (também aceita pipes/FIFOs)\n");
+        fprintf(stderr, "  alg_subst: lru, lru_linear, lfu, lfu_linear, fifo, random, clock, segunda_chance, wsclock,\n             arc, 2q, lirs, opt (offline: carrega o trace inteiro em memória)\n");
+        fprintf(stderr, "  Para selecionar a tabela de páginas, defina a variável de ambiente PAGE_TABLE_TYPE.\n");
+        fprintf(stderr, "  Tipos: densa, densa_virtual, hierarquica2, hierarquica3, invertida, invertida_aberta\n");
+        fprintf(stderr, "         densa_compacta, hierarquica2_compacta, hierarquica3_compacta\n");
+        fprintf(stderr, "  Ex: PAGE_TABLE_TYPE=invertida %s lru ...\n", argv[0]);
+        fprintf(stderr, "  TLB opcional: TLB_ENTRIES=<n> [TLB_ASSOC=<vias>] [TLB_REPL=lru|random]\n");
+        fprintf(stderr, "  Cache de caminhada (hierarquica2/3): PWC_ENTRIES=<n>\n");
+        fprintf(stderr, "  Comparação de cada política com o ótimo (OPT): COMPARAR_OPT=1\n");
+        fprintf(stderr, "  Páginas grandes: HUGE_PAGE_KB=<kb> [HUGE_PROMOTE=<páginas base residentes para promover>]\n");
+        fprintf(stderr, "       %s varredura ...  (várias configurações em uma leitura do trace)\n", argv[0]);
+        fprintf(stderr, "       %s mrc ...        (curva de faltas do LRU para todos os tamanhos de memória)\n", argv[0]);
+        fprintf(stderr, "       %s lote ...       (lista de simulações executadas em paralelo)\n", argv[0]);
+        return 1;
+    }
+    
+    Configuracao config;
+    memset(&config, 0, sizeof(config));
+    config.algoritmo = argv[1];
+    char* nome_arquivo = argv[2];
+    config.tam_pagina_kb = atoi(argv[3]);
+    config.tam_memoria_kb = atoi(argv[4]);
+
+    int debug_mode = (argc == 6 && strcmp(argv[5], "debug") == 0);
+
+    // --- Criação da Tabela de Páginas via Variável de Ambiente ---
+    char* nome_tipo_tabela = getenv("PAGE_TABLE_TYPE");
+
+    // Se a variável não estiver definida, usa um padrão e avisa o usuário.
+    if (nome_tipo_tabela == NULL) {
+        printf("Aviso: Variável de ambiente PAGE_TABLE_TYPE não definida. Usando 'hierarquica2' como padrão.\n");
+        nome_tipo_tabela = "hierarquica2";
+    }
+    config.tabela = nome_tipo_tabela;
+    config.origem_tabela = getenv("PAGE_TABLE_TYPE") ? "PAGE_TABLE_TYPE" : NULL;
+
+    // --- Inicialização ---
+    TraceCarregado* trace = NULL;
+    double tempo_carga = 0.0;
+    if (!carregar_trace_se_preciso(nome_arquivo, &config, 1, &trace, &tempo_carga)) {
+        return 1;
+    }
+    if (!criar_configuracao(&config, (unsigned long long)time(NULL))) {
+        trace_liberar(trace);
+        return 1;
+    }
+    config.sim->debug = debug_mode;
+
+    // --- Loop Principal e Relatório ---
+    int ok = executar_trace(nome_arquivo, &config, 1, tempo_carga);
+
+    // --- Limpeza ---
+    configuracao_destruir(&config);
+    trace_liberar(trace);
+    return ok ? 0 : 1;
 }
\ No newline at end of file
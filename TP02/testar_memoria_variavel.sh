@@ -13,7 +13,7 @@ echo ""
 
 # --- PARÂMETROS DE TESTE ---
 LOG_FILES="compilador.log matriz.log compressor.log simulador.log"
-ALGORITHMS="lru fifo lfu random"
+ALGORITHMS="lru fifo lfu random clock segunda_chance wsclock arc 2q lirs"
 MEM_SIZES="128 256 512 1024 2048"
 
 # --- VARIÁVEIS FIXAS PARA ESTE CENÁRIO ---
@@ -21,17 +21,14 @@ PAGE_SIZE=4
 TABLE_TYPE="hierarquica2" # Tabela padrão para uma comparação justa
 
 # --- LOOP DE EXECUÇÃO ---
+# Cada log é lido uma única vez: o modo varredura simula todas as
+# combinações de algoritmo e tamanho de memória na mesma passada
+ALG_LIST=$(echo $ALGORITHMS | tr ' ' ',')
+MEM_LIST=$(echo $MEM_SIZES | tr ' ' ',')
 for log in $LOG_FILES
 do
-    for alg in $ALGORITHMS
-    do
-        for mem in $MEM_SIZES
-        do
-            echo ">>> Teste: Log=$log, Alg=$alg, Mem=${mem}KB, Pag=${PAGE_SIZE}KB, Tabela=$TABLE_TYPE"
-            PAGE_TABLE_TYPE=$TABLE_TYPE ./simulador $alg $log $PAGE_SIZE $mem
-            echo ""
-        done
-    done
+    PAGE_TABLE_TYPE=$TABLE_TYPE ./simulador varredura $log $ALG_LIST $PAGE_SIZE $MEM_LIST
+    echo ""
 done
 
 echo "=========================================================================="
@@ -26,7 +26,7 @@ LOG_FILE_PT="compressor.log"
 MEM_SIZE_PT=1024  # 1MB
 PAGE_SIZE_PT=4    # 4KB
 ALGORITHM_PT="lru"
-for table_type in densa hierarquica2 hierarquica3 invertida
+for table_type in densa densa_virtual densa_compacta hierarquica2 hierarquica2_compacta hierarquica3 hierarquica3_compacta invertida invertida_aberta
 do
     echo ">>> Teste: Tabela=$table_type, Log=$LOG_FILE_PT, Alg=$ALGORITHM_PT, Mem=${MEM_SIZE_PT}KB, Pag=${PAGE_SIZE_PT}KB"
     # A tabela densa pode falhar por falta de memória. O '|| true' evita que o script pare.
@@ -43,21 +43,16 @@ echo ""
 echo "PARTE 2: ANÁLISE COM TAMANHO DE MEMÓRIA VARIÁVEL"
 echo "--------------------------------------------------------------------------"
 LOG_FILES="compilador.log matriz.log compressor.log simulador.log"
-ALGORITHMS="lru fifo lfu random"
+ALGORITHMS="lru fifo lfu random clock segunda_chance wsclock arc 2q lirs"
 PAGE_SIZE_MEM=4
 MEM_SIZES="128 256 512 1024 2048"
 TABLE_TYPE_MEM="hierarquica2"
+# Cada log é lido uma única vez pelo modo varredura, que simula todas as
+# combinações de algoritmo e memória na mesma passada.
 for log in $LOG_FILES
 do
-    for alg in $ALGORITHMS
-    do
-        for mem in $MEM_SIZES
-        do
-            echo ">>> Teste: Log=$log, Alg=$alg, Mem=${mem}KB, Pag=${PAGE_SIZE_MEM}KB, Tabela=$TABLE_TYPE_MEM"
-            PAGE_TABLE_TYPE=$TABLE_TYPE_MEM ./simulador $alg $log $PAGE_SIZE_MEM $mem
-            echo ""
-        done
-    done
+    PAGE_TABLE_TYPE=$TABLE_TYPE_MEM ./simulador varredura $log $(echo $ALGORITHMS | tr ' ' ',') $PAGE_SIZE_MEM $(echo $MEM_SIZES | tr ' ' ',')
+    echo ""
 done
 echo "=========================================================================="
 echo ""
@@ -75,12 +70,8 @@ PAGE_SIZES="2 4 8 16 32 64"
 TABLE_TYPE_PAGE="hierarquica2"
 for log in $LOG_FILES_PAGE
 do
-    for page in $PAGE_SIZES
-    do
-        echo ">>> Teste: Log=$log, Alg=$ALGORITHM_PAGE, Mem=${MEM_SIZE_PAGE}KB, Pag=${page}KB, Tabela=$TABLE_TYPE_PAGE"
-        PAGE_TABLE_TYPE=$TABLE_TYPE_PAGE ./simulador $ALGORITHM_PAGE $log $page $MEM_SIZE_PAGE
-        echo ""
-    done
+    PAGE_TABLE_TYPE=$TABLE_TYPE_PAGE ./simulador varredura $log $ALGORITHM_PAGE $(echo $PAGE_SIZES | tr ' ' ',') $MEM_SIZE_PAGE
+    echo ""
 done
 echo "=========================================================================="
 echo "FIM DA BATERIA DE TESTES."
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "tlb.h"
+
+typedef struct {
+    PageTable* interna;
+    int entradas;
+    int associatividade;
+    int num_conjuntos;
+    SubstituicaoTLB substituicao;
+
+    // Entradas do conjunto c ocupam [c * associatividade, (c + 1) * associatividade)
+    unsigned int* paginas;
+    int* quadros;
+    uint8_t* validas;
+    unsigned long* ultimo_uso; // para o LRU dentro do conjunto
+    unsigned long relogio;
+    uint64_t estado_random;
+
+    // Estatísticas
+    unsigned long consultas;
+    unsigned long acertos;
+    unsigned long custo_caminhadas; // custo das consultas à tabela real nas faltas
+    unsigned long invalidacoes;
+} TLB;
+
+static inline int conjunto_da_pagina(TLB* tlb, unsigned int page_num) {
+    return (int)(page_num % (unsigned int)tlb->num_conjuntos);
+}
+
+// Posição da página na TLB, ou -1
+static inline int procurar_tlb(TLB* tlb, unsigned int page_num) {
+    int base = conjunto_da_pagina(tlb, page_num) * tlb->associatividade;
+    for (int i = base; i < base + tlb->associatividade; i++) {
+        if (tlb->validas[i] && tlb->paginas[i] == page_num) return i;
+    }
+    return -1;
+}
+
+static int escolher_via(TLB* tlb, int base) {
+    for (int i = base; i < base + tlb->associatividade; i++) {
+        if (!tlb->validas[i]) return i;
+    }
+    if (tlb->substituicao == TLB_SUBST_RANDOM) {
+        // xorshift64*
+        tlb->estado_random ^= tlb->estado_random >> 12;
+        tlb->estado_random ^= tlb->estado_random << 25;
+        tlb->estado_random ^= tlb->estado_random >> 27;
+        uint64_t r = tlb->estado_random * 0x2545F4914F6CDD1DULL;
+        return base + (int)((r >> 32) % (uint64_t)tlb->associatividade);
+    }
+    int vitima = base;
+    for (int i = base + 1; i < base + tlb->associatividade; i++) {
+        if (tlb->ultimo_uso[i] < tlb->ultimo_uso[vitima]) vitima = i;
+    }
+    return vitima;
+}
+
+int lookup_tlb(PageTable* pt, unsigned int page_num, int* cost) {
+    TLB* tlb = (TLB*)pt->impl;
+    tlb->consultas++;
+    tlb->relogio++;
+
+    int posicao = procurar_tlb(tlb, page_num);
+    if (posicao != -1) {
+        tlb->acertos++;
+        tlb->ultimo_uso[posicao] = tlb->relogio;
+        *cost = 0;
+        return tlb->quadros[posicao];
+    }
+
+#ifdef INSTRUMENTACAO
+    tlb->interna->sondagens = pt->sondagens;
+#endif
+    int frame = tlb->interna->lookup(tlb->interna, page_num, cost);
+    tlb->custo_caminhadas += (unsigned long)*cost;
+    if (frame != -1) {
+        posicao = escolher_via(tlb, conjunto_da_pagina(tlb, page_num) * tlb->associatividade);
+        tlb->paginas[posicao] = page_num;
+        tlb->quadros[posicao] = frame;
+        tlb->validas[posicao] = 1;
+        tlb->ultimo_uso[posicao] = tlb->relogio;
+    }
+    return frame;
+}
+
+void update_tlb(PageTable* pt, unsigned int page_num, int frame_num) {
+    TLB* tlb = (TLB*)pt->impl;
+    int posicao = procurar_tlb(tlb, page_num);
+    if (posicao != -1) {
+        tlb->validas[posicao] = 0;
+        tlb->invalidacoes++;
+    }
+    tlb->interna->update(tlb->interna, page_num, frame_num);
+}
+
+void destroy_tlb(PageTable* pt) {
+    TLB* tlb = (TLB*)pt->impl;
+    tlb->interna->destroy(tlb->interna);
+    free(tlb->paginas);
+    free(tlb->quadros);
+    free(tlb->validas);
+    free(tlb->ultimo_uso);
+    free(tlb);
+    free(pt);
+}
+
+// A TLB é hardware: o custo de memória é o da tabela real
+size_t memory_cost_tlb(PageTable* pt) {
+    TLB* tlb = (TLB*)pt->impl;
+    return tlb->interna->memory_cost(tlb->interna);
+}
+
+void print_stats_tlb(PageTable* pt, FILE* out) {
+    TLB* tlb = (TLB*)pt->impl;
+    if (tlb->interna->print_stats) tlb->interna->print_stats(tlb->interna, out);
+
+    double consultas = tlb->consultas ? (double)tlb->consultas : 1.0;
+    unsigned long faltas = tlb->consultas - tlb->acertos;
+    fprintf(out, "TLB:\n");
+    fprintf(out, "  Configuração: %d entradas, %d vias (%d conjuntos), substituição %s\n",
+            tlb->entradas, tlb->associatividade, tlb->num_conjuntos,
+            tlb->substituicao == TLB_SUBST_LRU ? "lru" : "random");
+    fprintf(out, "  Taxa de acertos: %.2f%% (%lu de %lu consultas)\n",
+            100.0 * (double)tlb->acertos / consultas, tlb->acertos, tlb->consultas);
+    fprintf(out, "  Custo médio de uma falta de TLB (caminhada na tabela): %.2f acessos\n",
+            faltas ? (double)tlb->custo_caminhadas / (double)faltas : 0.0);
+    fprintf(out, "  Custo efetivo por acesso: %.3f acessos\n", (double)tlb->custo_caminhadas / consultas);
+    fprintf(out, "  Invalidações por substituição de página: %lu\n", tlb->invalidacoes);
+}
+
+PageTable* pagetable_tlb_create(PageTable* interna, int entradas, int associatividade,
+                                SubstituicaoTLB substituicao, unsigned long long semente) {
+    PageTable* pt = calloc(1, sizeof(PageTable));
+    TLB* tlb = calloc(1, sizeof(TLB));
+    pt->impl = tlb;
+    pt->lookup = lookup_tlb;
+    pt->update = update_tlb;
+    pt->destroy = destroy_tlb;
+    pt->memory_cost = memory_cost_tlb;
+    pt->print_stats = print_stats_tlb;
+
+    tlb->interna = interna;
+    tlb->entradas = entradas;
+    tlb->associatividade = associatividade;
+    tlb->num_conjuntos = entradas / associatividade;
+    tlb->substituicao = substituicao;
+    tlb->paginas = malloc(entradas * sizeof(unsigned int));
+    tlb->quadros = malloc(entradas * sizeof(int));
+    tlb->validas = calloc(entradas, sizeof(uint8_t));
+    tlb->ultimo_uso = calloc(entradas, sizeof(unsigned long));
+    tlb->estado_random = semente ? semente : 0x9E3779B97F4A7C15ULL;
+    return pt;
+}
+
+int pagetable_tlb_do_ambiente(PageTable** pt, unsigned long long semente) {
+    const char* variavel = getenv("TLB_ENTRIES");
+    if (variavel == NULL || atoi(variavel) == 0) return 1;
+
+    int entradas = atoi(variavel);
+    int associatividade = getenv("TLB_ASSOC") ? atoi(getenv("TLB_ASSOC")) : entradas;
+    if (entradas < 0 || associatividade <= 0 || associatividade > entradas || entradas % associatividade != 0) {
+        fprintf(stderr, "Erro: TLB inválida (%d entradas, %d vias). TLB_ENTRIES deve ser múltiplo de TLB_ASSOC.\n",
+                entradas, associatividade);
+        return 0;
+    }
+
+    SubstituicaoTLB substituicao = TLB_SUBST_LRU;
+    const char* nome = getenv("TLB_REPL");
+    if (nome != NULL && strcmp(nome, "random") == 0) {
+        substituicao = TLB_SUBST_RANDOM;
+    } else if (nome != NULL && strcmp(nome, "lru") != 0) {
+        fprintf(stderr, "Erro: substituição de TLB '%s' desconhecida (use lru ou random).\n", nome);
+        return 0;
+    }
+
+    *pt = pagetable_tlb_create(*pt, entradas, associatividade, substituicao, semente);
+    return 1;
+}
@@ -0,0 +1,26 @@
+#ifndef TLB_H
+#define TLB_H
+
+#include "pagetable.h"
+
+// TLB em software na frente de qualquer PageTable. A TLB é apresentada como
+// uma PageTable que envolve a tabela real: um acerto na TLB responde a
+// consulta com custo 0 (nenhum acesso à memória); uma falta percorre a tabela
+// real e guarda a tradução. Invalidar uma página (update com -1) também remove
+// a entrada da TLB, como o shootdown feito pelo sistema na substituição
+
+typedef enum {
+    TLB_SUBST_LRU,
+    TLB_SUBST_RANDOM
+} SubstituicaoTLB;
+
+// 'entradas' deve ser múltiplo de 'associatividade'. A TLB passa a ser dona da tabela 'interna'
+PageTable* pagetable_tlb_create(PageTable* interna, int entradas, int associatividade,
+                                SubstituicaoTLB substituicao, unsigned long long semente);
+
+// Envolve *pt com uma TLB se TLB_ENTRIES estiver definida (TLB_ASSOC: vias por
+// conjunto, padrão totalmente associativa; TLB_REPL: lru ou random). Retorna 0
+// (com mensagem de erro) se a configuração for inválida
+int pagetable_tlb_do_ambiente(PageTable** pt, unsigned long long semente);
+
+#endif
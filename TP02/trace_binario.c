@@ -0,0 +1,76 @@
+#include <stdlib.h>
+#include <string.h>
+#include "trace_binario.h"
+
+static int gravar_bloco(EscritorTraceBinario* escritor) {
+    if (escritor->acessos_bloco == 0) return 1;
+
+    unsigned char cabecalho[TRACE_BIN_TAM_CABECALHO_BLOCO];
+    trace_bin_escrever_u32(cabecalho, escritor->acessos_bloco);
+    trace_bin_escrever_u32(cabecalho + 4, (uint32_t)escritor->tamanho_dados);
+    if (fwrite(cabecalho, 1, sizeof(cabecalho), escritor->arquivo) != sizeof(cabecalho)) return 0;
+    if (fwrite(escritor->dados, 1, escritor->tamanho_dados, escritor->arquivo) != escritor->tamanho_dados) return 0;
+
+    escritor->acessos_bloco = 0;
+    escritor->tamanho_dados = 0;
+    escritor->endereco_anterior = 0;
+    return 1;
+}
+
+static void montar_cabecalho(unsigned char* cabecalho, uint64_t total_acessos) {
+    memset(cabecalho, 0, TRACE_BIN_TAM_CABECALHO);
+    memcpy(cabecalho, TRACE_BIN_ASSINATURA, 4);
+    cabecalho[4] = TRACE_BIN_VERSAO;
+    trace_bin_escrever_u32(cabecalho + 8, (uint32_t)total_acessos);
+    trace_bin_escrever_u32(cabecalho + 12, (uint32_t)(total_acessos >> 32));
+}
+
+EscritorTraceBinario* escritor_binario_abrir(const char* nome_arquivo) {
+    EscritorTraceBinario* escritor = calloc(1, sizeof(EscritorTraceBinario));
+    if (!escritor) return NULL;
+
+    escritor->dados = malloc((size_t)TRACE_BIN_ACESSOS_POR_BLOCO * TRACE_BIN_MAX_VARINT);
+    escritor->arquivo = fopen(nome_arquivo, "wb");
+    if (!escritor->dados || !escritor->arquivo) {
+        if (escritor->arquivo) fclose(escritor->arquivo);
+        free(escritor->dados);
+        free(escritor);
+        return NULL;
+    }
+
+    // O total de acessos é reescrito no fechamento
+    unsigned char cabecalho[TRACE_BIN_TAM_CABECALHO];
+    montar_cabecalho(cabecalho, 0);
+    fwrite(cabecalho, 1, sizeof(cabecalho), escritor->arquivo);
+    return escritor;
+}
+
+int escritor_binario_adicionar(EscritorTraceBinario* escritor, uint32_t endereco, char tipo_acesso) {
+    escritor->tamanho_dados += trace_bin_codificar(escritor->dados + escritor->tamanho_dados,
+                                                   endereco, escritor->endereco_anterior,
+                                                   tipo_acesso == 'W');
+    escritor->endereco_anterior = endereco;
+    escritor->acessos_bloco++;
+    escritor->total_acessos++;
+
+    if (escritor->acessos_bloco == TRACE_BIN_ACESSOS_POR_BLOCO) {
+        return gravar_bloco(escritor);
+    }
+    return 1;
+}
+
+int escritor_binario_fechar(EscritorTraceBinario* escritor) {
+    int ok = gravar_bloco(escritor);
+
+    // Atualiza o total de acessos no cabeçalho, se o destino permitir
+    unsigned char cabecalho[TRACE_BIN_TAM_CABECALHO];
+    montar_cabecalho(cabecalho, escritor->total_acessos);
+    if (ok && fseek(escritor->arquivo, 0, SEEK_SET) == 0) {
+        ok = fwrite(cabecalho, 1, sizeof(cabecalho), escritor->arquivo) == sizeof(cabecalho);
+    }
+
+    if (fclose(escritor->arquivo) != 0) ok = 0;
+    free(escritor->dados);
+    free(escritor);
+    return ok;
+}
@@ -0,0 +1,98 @@
+#ifndef TRACE_BINARIO_H
+#define TRACE_BINARIO_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Formato binário compacto para traces de acesso à memória
+//
+// Cabeçalho (16 bytes):
+//   bytes 0-3   assinatura "\x89TRC" (o primeiro byte nunca aparece em um log texto)
+//   byte  4     versão do formato
+//   bytes 5-7   reservados (zero)
+//   bytes 8-15  total de acessos no arquivo (little-endian, 0 se desconhecido)
+//
+// Em seguida vêm blocos independentes, cada um com um cabeçalho de 8 bytes:
+//   bytes 0-3   número de acessos no bloco (little-endian)
+//   bytes 4-7   tamanho em bytes dos dados do bloco (little-endian)
+// e os dados: um varint (LEB128) por acesso contendo
+//   (zigzag(endereco - endereco_anterior) << 1) | escrita
+// O endereço anterior é zerado no início de cada bloco, para que os blocos
+// possam ser decodificados separadamente
+
+#define TRACE_BIN_ASSINATURA "\x89TRC"
+#define TRACE_BIN_VERSAO 1
+#define TRACE_BIN_TAM_CABECALHO 16
+#define TRACE_BIN_TAM_CABECALHO_BLOCO 8
+#define TRACE_BIN_ACESSOS_POR_BLOCO 65536
+// Pior caso de um varint de 33 bits
+#define TRACE_BIN_MAX_VARINT 5
+
+static inline uint32_t trace_bin_ler_u32(const unsigned char* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void trace_bin_escrever_u32(unsigned char* p, uint32_t v) {
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+// Codifica um acesso. Retorna o número de bytes escritos em 'saida'
+static inline int trace_bin_codificar(unsigned char* saida, uint32_t endereco, uint32_t anterior, int escrita) {
+    int32_t delta = (int32_t)(endereco - anterior);
+    uint32_t zigzag = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+    uint64_t valor = ((uint64_t)zigzag << 1) | (escrita ? 1u : 0u);
+    int n = 0;
+    while (valor >= 0x80) {
+        saida[n++] = (unsigned char)(valor | 0x80);
+        valor >>= 7;
+    }
+    saida[n++] = (unsigned char)valor;
+    return n;
+}
+
+// Decodifica um acesso a partir de 'p' sem ultrapassar 'fim'.
+// Retorna o ponteiro para o próximo acesso, ou NULL se os dados estiverem corrompidos
+static inline const unsigned char* trace_bin_decodificar(const unsigned char* p, const unsigned char* fim,
+                                                         uint32_t* endereco, int* escrita) {
+    uint64_t valor = 0;
+    int deslocamento = 0;
+    while (p < fim && deslocamento < 7 * TRACE_BIN_MAX_VARINT) {
+        unsigned char byte = *p++;
+        valor |= (uint64_t)(byte & 0x7F) << deslocamento;
+        if (!(byte & 0x80)) {
+            uint32_t zigzag = (uint32_t)(valor >> 1);
+            uint32_t delta = (zigzag >> 1) ^ (0u - (zigzag & 1));
+            *endereco += delta;
+            *escrita = (int)(valor & 1);
+            return p;
+        }
+        deslocamento += 7;
+    }
+    return NULL;
+}
+
+// --- Escrita de traces binários ---
+
+typedef struct {
+    FILE* arquivo;
+    unsigned char* dados;       // dados do bloco em construção
+    size_t tamanho_dados;
+    uint32_t acessos_bloco;
+    uint32_t endereco_anterior;
+    uint64_t total_acessos;
+} EscritorTraceBinario;
+
+// Cria o arquivo e escreve o cabeçalho. Retorna NULL (com errno definido) em caso de erro
+EscritorTraceBinario* escritor_binario_abrir(const char* nome_arquivo);
+
+// Adiciona um acesso. Retorna 0 se houve erro de escrita
+int escritor_binario_adicionar(EscritorTraceBinario* escritor, uint32_t endereco, char tipo_acesso);
+
+// Grava o último bloco, atualiza o total no cabeçalho e fecha. Retorna 0 se houve erro
+int escritor_binario_fechar(EscritorTraceBinario* escritor);
+
+#endif